@@ -0,0 +1,2 @@
+// Objective-C++ wrapper for Xcode (Syphon requires ObjC compilation)
+#include "SourceRegistry.cpp"
@@ -1,6 +1,7 @@
 #include "win_byte_fix.h"
 #include "AuthManager.h"
 #include "SupabaseConfig.h"
+#include "HttpClient.h"
 #include <fstream>
 #include <sstream>
 #include <cstdlib>
@@ -98,71 +99,34 @@ void AuthManager::logout() {
 // ─── HTTP helper ─────────────────────────────────────────────────────────────
 
 bool AuthManager::httpPost(const std::string& url,
-                            const std::string& extraHeaders,
+                            const std::vector<std::string>& extraHeaders,
                             const std::string& jsonBody,
                             ofJson& outResponse,
                             std::string& outError) {
-    ensureVsDir();
-    std::string bodyFile = getVsDir() + "/auth_body.json";
-    std::string respFile = getVsDir() + "/auth_resp.json";
-
-    // Write body to file (avoids shell-escaping issues with passwords)
-    {
-        std::ofstream bf(bodyFile);
-        if (!bf.is_open()) {
-            outError = "Could not write temp file";
-            return false;
-        }
-        bf << jsonBody;
-    }
-
-#ifdef TARGET_OSX
-    std::string cmd = "curl -s -X POST "
-        "-H \"apikey: " + std::string(SUPABASE_ANON_KEY) + "\" "
-        "-H \"Content-Type: application/json\" ";
-
-    if (!extraHeaders.empty()) {
-        cmd += extraHeaders + " ";
-    }
-
-    cmd += "-d @\"" + bodyFile + "\" "
-           "\"" + url + "\" "
-           "-o \"" + respFile + "\" 2>/dev/null";
-
-#elif defined(TARGET_WIN32)
-    std::string cmd = "powershell -Command \""
-        "$h = @{'apikey'='" + std::string(SUPABASE_ANON_KEY) + "';"
-        "'Content-Type'='application/json'};";
-    if (!extraHeaders.empty()) {
-        cmd += extraHeaders;
-    }
-    cmd += "Invoke-RestMethod -Method POST -Uri '" + url + "' "
-           "-Headers $h "
-           "-InFile '" + bodyFile + "' "
-           "-OutFile '" + respFile + "'\"";
-#endif
-
-#ifdef TARGET_WIN32
-    silentSystem(cmd);
-#else
-    system(cmd.c_str());
-#endif
-    std::remove(bodyFile.c_str());
-
-    std::ifstream rf(respFile);
-    if (!rf.is_open()) {
+    HttpClient::Request req;
+    req.method  = "POST";
+    req.url     = url;
+    req.body    = jsonBody;
+    req.headers = {
+        "apikey: " + std::string(SUPABASE_ANON_KEY),
+        "Content-Type: application/json",
+    };
+    req.headers.insert(req.headers.end(), extraHeaders.begin(), extraHeaders.end());
+
+    HttpClient::Response res = HttpClient::get().send(req);
+    if (res.status == 0) {
         outError = "Network error or no internet connection";
         return false;
     }
+    // GoTrue reports failures (bad password, unconfirmed email) as a JSON
+    // body on 4xx — hand it to the caller, which reads the error fields
     try {
-        outResponse = ofJson::parse(rf);
+        outResponse = ofJson::parse(res.body);
     } catch (...) {
-        outError = "Invalid response from server";
-        std::remove(respFile.c_str());
+        outError = res.ok() ? "Invalid response from server"
+                            : "Server error (HTTP " + ofToString(res.status) + ")";
         return false;
     }
-    rf.close();
-    std::remove(respFile.c_str());
     return true;
 }
 
@@ -176,7 +140,7 @@ bool AuthManager::login(const std::string& email, const std::string& password,
 
     std::string url = std::string(SUPABASE_URL) + "/auth/v1/token?grant_type=password";
 
-    if (!httpPost(url, "", body.dump(), resp, outError)) {
+    if (!httpPost(url, {}, body.dump(), resp, outError)) {
         return false;
     }
 
@@ -226,7 +190,7 @@ bool AuthManager::signup(const std::string& email, const std::string& password,
 
     std::string url = std::string(SUPABASE_URL) + "/auth/v1/signup";
 
-    if (!httpPost(url, "", body.dump(), resp, outError)) {
+    if (!httpPost(url, {}, body.dump(), resp, outError)) {
         return false;
     }
 
@@ -285,7 +249,7 @@ bool AuthManager::refreshToken(std::string& outError) {
 
     std::string url = std::string(SUPABASE_URL) + "/auth/v1/token?grant_type=refresh_token";
 
-    if (!httpPost(url, "", body.dump(), resp, outError)) {
+    if (!httpPost(url, {}, body.dump(), resp, outError)) {
         return false; // No internet — silent failure, offline mode continues
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "ofMain.h"
 #include <string>
+#include <vector>
 #include <mutex>
 
 // Handles Supabase email/password auth and local session persistence.
@@ -46,9 +47,9 @@ private:
 
     void saveSession();
 
-    // Writes jsonBody to a temp file, runs curl POST, reads response JSON.
+    // POSTs jsonBody through the shared HttpClient and parses the response JSON.
     bool httpPost(const std::string& url,
-                  const std::string& extraHeaders, // newline-separated -H strings
+                  const std::vector<std::string>& extraHeaders, // "Name: value"
                   const std::string& jsonBody,
                   ofJson& outResponse,
                   std::string& outError);
@@ -0,0 +1,97 @@
+#include "win_byte_fix.h"
+#include "AutosaveWriter.h"
+#include "ProjectFile.h"
+
+AutosaveWriter::AutosaveWriter() {
+    worker = std::thread(&AutosaveWriter::run, this);
+}
+
+AutosaveWriter::~AutosaveWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    cv.notify_one();
+    if (worker.joinable()) worker.join();
+}
+
+void AutosaveWriter::submit(const std::string& path, ofJson data, const std::string& tag) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        jobPath = path;
+        jobData = std::move(data); // supersedes a snapshot not yet written
+        jobTag = tag;
+        jobSeq = nextSeq++;
+        hasJob = true;
+    }
+    cv.notify_one();
+}
+
+bool AutosaveWriter::pollResult(Result& out) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (results.empty()) return false;
+    out = std::move(results.front());
+    results.pop_front();
+    return true;
+}
+
+bool AutosaveWriter::save(const std::string& path, const ofJson& data) {
+    uint64_t seq;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (hasJob && jobPath == path) hasJob = false;
+        seq = nextSeq++;
+    }
+    bool wrote = false;
+    return write(path, ProjectFile::encode(data, ProjectFile::formatForPath(path)), seq, wrote);
+}
+
+bool AutosaveWriter::write(const std::string& path, const std::string& bytes, uint64_t seq, bool& wrote) {
+    wrote = false;
+    size_t hash = std::hash<std::string>()(bytes);
+    std::lock_guard<std::mutex> lock(writeMtx);
+    if (path == lastPath && (seq < lastSeq || hash == lastHash)) return true; // newer or same on disk
+
+    if (!ProjectFile::writeAtomically(path, bytes)) {
+        if (path == lastPath) lastPath.clear(); // unknown on disk now
+        return false;
+    }
+    lastPath = path;
+    lastHash = hash;
+    lastSeq = seq;
+    wrote = true;
+    return true;
+}
+
+// ── Worker ──────────────────────────────────────────────────────────────────
+
+void AutosaveWriter::run() {
+    while (true) {
+        std::string path;
+        ofJson data;
+        Result result;
+        uint64_t seq;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this]() { return hasJob || stopping; });
+            if (!hasJob) return; // stopping with nothing left to write
+            path = std::move(jobPath);
+            data = std::move(jobData);
+            result.tag = std::move(jobTag);
+            seq = jobSeq;
+            hasJob = false;
+        }
+
+        bool wrote = false;
+        result.ok = write(path, ProjectFile::encode(data, ProjectFile::formatForPath(path)), seq, wrote);
+        if (wrote) {
+            ofLogNotice("AutosaveWriter") << "Autosaved: " << path;
+        } else if (!result.ok) {
+            ofLogError("AutosaveWriter") << "Autosave failed: " << path;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            results.push_back(std::move(result));
+        }
+    }
+}
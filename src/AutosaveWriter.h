@@ -0,0 +1,64 @@
+#pragma once
+#include "ofMain.h"
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Writes project snapshots on a worker thread so autosave never blocks a
+// frame. The main thread hands over an already-built ofJson; the worker
+// encodes it (JSON or binary, by extension), skips the write when the bytes
+// match what was last written to that path, and otherwise writes
+// "<path>.tmp" and renames it over the target.
+// Only the newest pending snapshot is kept. Each snapshot written (or found
+// already on disk) reports back with the tag it was submitted under, so the
+// caller can tell a finished autosave from a failed one.
+//
+// Manual saves go through save(), so every write of a project file passes
+// through here: writes never overlap, an older snapshot never lands over a
+// newer one, and "last written" always matches what is on disk.
+class AutosaveWriter {
+public:
+    AutosaveWriter();
+    ~AutosaveWriter(); // finishes any pending write
+
+    void submit(const std::string& path, ofJson data, const std::string& tag = "");
+
+    // Outcome of a submitted snapshot; one superseded before it was written
+    // never reports
+    struct Result {
+        std::string tag;
+        bool ok = false;
+    };
+    // Oldest unread outcome — main thread, once per frame
+    bool pollResult(Result& out);
+
+    // Write now on the calling thread (manual save); a pending autosave of
+    // the same path is older and is dropped
+    bool save(const std::string& path, const ofJson& data);
+
+private:
+    void run();
+    // False only on a failed write; wrote tells whether the file was touched
+    bool write(const std::string& path, const std::string& bytes, uint64_t seq, bool& wrote);
+
+    std::thread worker;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+    bool hasJob = false;
+    std::string jobPath;
+    ofJson jobData;
+    std::string jobTag;
+    uint64_t jobSeq = 0;
+    uint64_t nextSeq = 1; // snapshot order, under mtx
+    std::deque<Result> results; // under mtx
+
+    // One write at a time; guards the last file written, a hash of its
+    // contents and the snapshot it came from
+    std::mutex writeMtx;
+    std::string lastPath;
+    size_t lastHash = 0;
+    uint64_t lastSeq = 0;
+};
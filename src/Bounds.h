@@ -0,0 +1,89 @@
+#pragma once
+#include "ofMain.h"
+#include <algorithm>
+#include <limits>
+
+// Axis-aligned box in world space
+struct AABB {
+    glm::vec3 min{ std::numeric_limits<float>::max()};
+    glm::vec3 max{-std::numeric_limits<float>::max()};
+
+    bool isEmpty() const { return min.x > max.x; }
+
+    void expand(const glm::vec3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+
+    void expand(const AABB& b) {
+        min = glm::min(min, b.min);
+        max = glm::max(max, b.max);
+    }
+
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+
+    bool operator==(const AABB& b) const { return min == b.min && max == b.max; }
+    bool operator!=(const AABB& b) const { return !(*this == b); }
+
+    // Box of a local-space box after an affine transform (center/extent form)
+    static AABB transformed(const glm::mat4& m, const glm::vec3& lmin, const glm::vec3& lmax) {
+        glm::vec3 c = (lmin + lmax) * 0.5f;
+        glm::vec3 e = (lmax - lmin) * 0.5f;
+        glm::vec3 wc = glm::vec3(m * glm::vec4(c, 1.0f));
+        glm::vec3 we;
+        for (int r = 0; r < 3; r++) {
+            we[r] = std::abs(m[0][r]) * e.x + std::abs(m[1][r]) * e.y + std::abs(m[2][r]) * e.z;
+        }
+        AABB b;
+        b.min = wc - we;
+        b.max = wc + we;
+        return b;
+    }
+
+    // Slab test; on hit, tNear is the entry distance (clamped to 0)
+    bool intersectRay(const glm::vec3& origin, const glm::vec3& invDir, float tMax, float& tNear) const {
+        float t0 = 0.0f, t1 = tMax;
+        for (int a = 0; a < 3; a++) {
+            float ta = (min[a] - origin[a]) * invDir[a];
+            float tb = (max[a] - origin[a]) * invDir[a];
+            if (ta > tb) std::swap(ta, tb);
+            t0 = std::max(t0, ta);
+            t1 = std::min(t1, tb);
+            if (t0 > t1) return false;
+        }
+        tNear = t0;
+        return true;
+    }
+};
+
+// Six inward-facing planes (xyz = normal, w = offset)
+struct Frustum {
+    glm::vec4 planes[6];
+
+    // Frustum of a view-projection matrix restricted to an NDC sub-rectangle
+    // (full view: -1..1 on both axes). Used for culling and box selection.
+    static Frustum fromMatrix(const glm::mat4& viewProj,
+                              float ndcMinX = -1, float ndcMaxX = 1,
+                              float ndcMinY = -1, float ndcMaxY = 1) {
+        glm::mat4 m = glm::transpose(viewProj); // rows as columns
+        Frustum f;
+        f.planes[0] = m[0] - m[3] * ndcMinX;                        // x >= minX * w
+        f.planes[1] = m[3] * ndcMaxX - m[0];                        // x <= maxX * w
+        f.planes[2] = m[1] - m[3] * ndcMinY;                        // y >= minY * w
+        f.planes[3] = m[3] * ndcMaxY - m[1];                        // y <= maxY * w
+        f.planes[4] = m[3] + m[2];                                  // near
+        f.planes[5] = m[3] - m[2];                                  // far
+        return f;
+    }
+
+    // Conservative: false only when the box is fully outside one plane
+    bool intersects(const AABB& b) const {
+        for (const auto& p : planes) {
+            glm::vec3 v(p.x >= 0 ? b.max.x : b.min.x,
+                        p.y >= 0 ? b.max.y : b.min.y,
+                        p.z >= 0 ? b.max.z : b.min.z);
+            if (p.x * v.x + p.y * v.y + p.z * v.z + p.w < 0) return false;
+        }
+        return true;
+    }
+};
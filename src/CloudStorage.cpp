@@ -1,139 +1,125 @@
 #include "win_byte_fix.h"
 #include "CloudStorage.h"
 #include "SupabaseConfig.h"
-#include <fstream>
+#include "HttpClient.h"
+#include "Fnv1a.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
 #include <cstdlib>
 
-#ifdef TARGET_OSX
-#include <sys/stat.h>
-#endif
-
-// ─── Helpers ─────────────────────────────────────────────────────────────────
-
-static std::string getHomeDir() {
-    const char* h = getenv("HOME");
-#ifdef TARGET_WIN32
-    if (!h) h = getenv("USERPROFILE");
-#endif
-    return h ? std::string(h) : std::string("/tmp");
-}
-
-std::string CloudStorage::getTmpDir() const {
-    return getHomeDir() + "/.virtualstage";
-}
-
-void CloudStorage::ensureTmpDir() const {
-    std::string d = getTmpDir();
-#ifdef TARGET_OSX
-    mkdir(d.c_str(), 0700);
-#elif defined(TARGET_WIN32)
-    CreateDirectoryA(d.c_str(), NULL);
-#endif
-}
-
 // ─── REST request ─────────────────────────────────────────────────────────────
 
 bool CloudStorage::restRequest(const std::string& method,
                                 const std::string& endpoint,
                                 const AuthManager::Session& session,
-                                const std::string& extraHeaders,
+                                const std::vector<std::string>& extraHeaders,
                                 const std::string& jsonBody,
                                 ofJson& outResponse,
                                 std::string& outError) {
-    ensureTmpDir();
-    std::string dir      = getTmpDir();
-    std::string bodyFile = dir + "/cloud_body.json";
-    std::string respFile = dir + "/cloud_resp.json";
-
-    std::string url = std::string(SUPABASE_URL) + endpoint;
-
-    bool hasBody = !jsonBody.empty();
-    if (hasBody) {
-        std::ofstream bf(bodyFile);
-        if (!bf.is_open()) { outError = "Could not write temp file"; return false; }
-        bf << jsonBody;
-    }
-
-#ifdef TARGET_OSX
-    std::string cmd = "curl -s -X " + method + " "
-        "-H \"apikey: " + std::string(SUPABASE_ANON_KEY) + "\" "
-        "-H \"Authorization: Bearer " + session.accessToken + "\" ";
-
-    if (hasBody) {
-        cmd += "-H \"Content-Type: application/json\" ";
-    }
-    if (!extraHeaders.empty()) {
-        cmd += extraHeaders + " ";
-    }
-    if (hasBody) {
-        cmd += "-d @\"" + bodyFile + "\" ";
-    }
-    cmd += "\"" + url + "\" -o \"" + respFile + "\" 2>/dev/null";
-
-#elif defined(TARGET_WIN32)
-    std::string cmd = "powershell -Command \""
-        "$h = @{"
-        "'apikey'='" + std::string(SUPABASE_ANON_KEY) + "';"
-        "'Authorization'='Bearer " + session.accessToken + "'";
-    if (hasBody) cmd += ";"
-        "'Content-Type'='application/json'";
-    if (!extraHeaders.empty()) cmd += ";" + extraHeaders;
-    cmd += "};";
-    if (hasBody) {
-        cmd += "Invoke-RestMethod -Method " + method +
-               " -Uri '" + url + "' -Headers $h -InFile '" + bodyFile + "'"
-               " -OutFile '" + respFile + "'\"";
-    } else {
-        cmd += "Invoke-RestMethod -Method " + method +
-               " -Uri '" + url + "' -Headers $h"
-               " -OutFile '" + respFile + "'\"";
-    }
-#endif
-
-#ifdef TARGET_WIN32
-    silentSystem(cmd);
-#else
-    system(cmd.c_str());
-#endif
-
-    if (hasBody) std::remove(bodyFile.c_str());
-
-    std::ifstream rf(respFile);
-    if (!rf.is_open()) {
-        // Empty response is OK for DELETE (204 No Content)
-        outResponse = ofJson::array();
-        return true;
-    }
-    try {
-        outResponse = ofJson::parse(rf);
-    } catch (...) {
-        outResponse = ofJson::array();
-        rf.close();
-        std::remove(respFile.c_str());
-        return true; // empty / non-JSON response treated as success
+    HttpClient::Request req;
+    req.method = method;
+    req.url    = std::string(SUPABASE_URL) + endpoint;
+    req.body   = jsonBody;
+    req.headers = {
+        "apikey: " + std::string(SUPABASE_ANON_KEY),
+        "Authorization: Bearer " + session.accessToken,
+    };
+    if (!jsonBody.empty()) req.headers.push_back("Content-Type: application/json");
+    req.headers.insert(req.headers.end(), extraHeaders.begin(), extraHeaders.end());
+
+    HttpClient::Response res = HttpClient::get().send(req);
+    if (res.status == 0) {
+        outError = "Network error: " + res.error;
+        return false;
     }
-    rf.close();
-    std::remove(respFile.c_str());
 
-    // Check for PostgREST error object
-    if (outResponse.is_object() && outResponse.contains("message")) {
-        outError = outResponse.value("message", "Request failed");
-        return false;
+    // Empty body is normal for DELETE (204) and upserts without return=representation
+    outResponse = ofJson::array();
+    if (!res.body.empty()) {
+        try {
+            outResponse = ofJson::parse(res.body);
+        } catch (...) {
+            if (!res.ok()) {
+                outError = "Request failed (HTTP " + ofToString(res.status) + ")";
+                return false;
+            }
+            return true; // non-JSON success body
+        }
     }
-    if (outResponse.is_object() && outResponse.contains("error")) {
-        outError = outResponse.value("error", "Request failed");
-        return false;
+    if (res.ok()) return true;
+
+    // PostgREST / GoTrue error object
+    outError = "Request failed (HTTP " + ofToString(res.status) + ")";
+    if (outResponse.is_object()) {
+        for (const char* key : { "message", "error", "msg" }) {
+            if (outResponse.contains(key) && outResponse[key].is_string()) {
+                outError = outResponse[key].get<std::string>();
+                break;
+            }
+        }
     }
-    if (outResponse.is_object() && outResponse.contains("msg")) {
-        outError = outResponse.value("msg", "Request failed");
-        return false;
+    return false;
+}
+
+// ─── Hashing ──────────────────────────────────────────────────────────────────
+
+// One hash per screen; the project hash covers everything but the screens
+// plus the screen hashes in order
+static std::string hashProject(const ofJson& meta, const ofJson& screens,
+                               std::vector<uint64_t>& outScreenHashes) {
+    uint64_t h = Fnv1a::hash(meta.dump());
+    outScreenHashes.clear();
+    outScreenHashes.reserve(screens.size());
+    for (const auto& screen : screens) {
+        uint64_t sh = Fnv1a::hash(screen.dump());
+        outScreenHashes.push_back(sh);
+        h = Fnv1a::combine(h, sh);
     }
+    return Fnv1a::hex(h);
+}
 
-    return true;
+static std::string urlEncode(const std::string& s) {
+    static const char* hex = "0123456789ABCDEF";
+    std::string out;
+    for (unsigned char c : s) {
+        if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            out += (char)c;
+        } else {
+            out += '%';
+            out += hex[c >> 4];
+            out += hex[c & 15];
+        }
+    }
+    return out;
 }
 
 // ─── CRUD operations ──────────────────────────────────────────────────────────
 
+CloudStorage::CloudStorage()
+    : cacheRoot(ofFilePath::join(ofFilePath::getUserHomeDir(), ".virtualstage/cache")) {}
+
+ProjectCache& CloudStorage::cacheFor(const AuthManager::Session& session) {
+    std::string user = session.userId.empty() ? "anonymous" : session.userId;
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto& cache = caches[user];
+    if (!cache) cache = std::make_unique<ProjectCache>(ofFilePath::join(cacheRoot, user));
+    return *cache;
+}
+
+static void parseProjectList(const ofJson& resp, std::vector<CloudStorage::CloudProject>& out) {
+    out.clear();
+    if (!resp.is_array()) return;
+
+    for (auto& item : resp) {
+        CloudStorage::CloudProject p;
+        p.id        = item.value("id",         std::string());
+        p.name      = item.value("name",        std::string());
+        p.updatedAt = item.value("updated_at",  std::string());
+        if (!p.id.empty()) out.push_back(p);
+    }
+}
+
 bool CloudStorage::listProjects(const AuthManager::Session& session,
                                  std::vector<CloudProject>& outProjects,
                                  std::string& outError) {
@@ -141,20 +127,20 @@ bool CloudStorage::listProjects(const AuthManager::Session& session,
     std::string endpoint = "/rest/v1/projects?select=id,name,updated_at"
                            "&order=updated_at.desc";
 
-    if (!restRequest("GET", endpoint, session, "", "", resp, outError)) {
+    if (!restRequest("GET", endpoint, session, {}, "", resp, outError)) {
         return false;
     }
 
-    outProjects.clear();
-    if (!resp.is_array()) return true;
+    parseProjectList(resp, outProjects);
+    if (resp.is_array()) cacheFor(session).storeList(resp);
+    return true;
+}
 
-    for (auto& item : resp) {
-        CloudProject p;
-        p.id        = item.value("id",         std::string());
-        p.name      = item.value("name",        std::string());
-        p.updatedAt = item.value("updated_at",  std::string());
-        if (!p.id.empty()) outProjects.push_back(p);
-    }
+bool CloudStorage::listCachedProjects(const AuthManager::Session& session,
+                                       std::vector<CloudProject>& outProjects) {
+    ofJson list;
+    if (!cacheFor(session).loadList(list)) return false;
+    parseProjectList(list, outProjects);
     return true;
 }
 
@@ -162,26 +148,259 @@ bool CloudStorage::saveProject(const AuthManager::Session& session,
                                 const ofJson& projectData,
                                 const std::string& projectName,
                                 std::string& outError) {
+    static const ofJson noScreens = ofJson::array();
+    const ofJson& screens = projectData.contains("screens") && projectData["screens"].is_array()
+        ? projectData["screens"] : noScreens;
+    ofJson meta = projectData;
+    meta.erase("screens");
+
+    std::vector<uint64_t> screenHashes;
+    std::string contentHash = hashProject(meta, screens, screenHashes);
+
+    // What the server has now: a matching hash means nothing to upload
+    ofJson resp;
+    std::string endpoint = "/rest/v1/projects?name=eq." + urlEncode(projectName) +
+                           "&select=id,hash:data->>contentHash,rows:data->>screenRows";
+    if (!restRequest("GET", endpoint, session, {}, "", resp, outError)) {
+        return false;
+    }
+    std::string projectId, remoteHash;
+    int remoteRows = -1; // screenRows of a split project, -1 while whole
+    if (resp.is_array() && !resp.empty()) {
+        projectId  = resp[0].value("id", std::string());
+        remoteHash = resp[0]["hash"].is_string() ? resp[0]["hash"].get<std::string>() : "";
+        if (resp[0]["rows"].is_string()) remoteRows = ofToInt(resp[0]["rows"].get<std::string>());
+    }
+    if (!remoteHash.empty() && remoteHash == contentHash) {
+        ofLogVerbose("CloudStorage") << "Unchanged, upload skipped: " << projectName;
+        return true;
+    }
+
+    // Once split, a project stays split even if it shrinks
+    bool saved = false;
+    std::string version;
+    if (!screensTableMissing && (remoteRows >= 0 || screens.size() >= SPLIT_SCREENS)) {
+        saved = saveSplit(session, projectName, projectId, remoteHash, remoteRows, meta, screens,
+                          screenHashes, contentHash, version, outError);
+        if (!saved && outError.find("project_screens") == std::string::npos) return false;
+        if (!saved) {
+            ofLogWarning("CloudStorage") << "project_screens table unavailable, saving whole projects: " << outError;
+            screensTableMissing = true;
+        }
+    }
+    if (!saved) {
+        ofJson data = projectData;
+        data["contentHash"] = contentHash;
+        if (!upsertProjectRow(session, projectName, data, projectId, &version, outError)) return false;
+    }
+
+    // What we uploaded is now the server's current version
+    if (!projectId.empty() && !version.empty()) cacheFor(session).store(projectId, version, projectData);
+    return true;
+}
+
+bool CloudStorage::saveSplit(const AuthManager::Session& session,
+                              const std::string& projectName,
+                              std::string& projectId,
+                              const std::string& remoteHash,
+                              int remoteRows,
+                              const ofJson& meta,
+                              const ofJson& screens,
+                              const std::vector<uint64_t>& screenHashes,
+                              const std::string& contentHash,
+                              std::string& outVersion,
+                              std::string& outError) {
+    ofJson data = meta;
+
+    // Any failure leaves rows the remembered hashes no longer describe
+    auto fail = [&]() {
+        std::lock_guard<std::mutex> lock(syncMutex);
+        synced.erase(projectId);
+        return false;
+    };
+
+    // A new project needs its id before rows can reference it. It starts as
+    // an empty split project: screenRows and the hash are only stored once
+    // every row is in, so an interrupted save never names rows that are
+    // missing and is never taken for "unchanged"
+    if (projectId.empty()) {
+        data["screenRows"] = 0;
+        if (!upsertProjectRow(session, projectName, data, projectId, nullptr, outError)) return fail();
+    }
+
+    // Row hashes on the server: remembered from our last save or load while
+    // the project hash still matches, otherwise read back
+    std::vector<uint64_t> remote;
+    bool known = false;
+    {
+        std::lock_guard<std::mutex> lock(syncMutex);
+        auto it = synced.find(projectId);
+        if (it != synced.end() && !remoteHash.empty() && it->second.contentHash == remoteHash) {
+            remote = it->second.screenHashes;
+            known = true;
+        }
+    }
+    if (!known) {
+        ofJson rows;
+        if (!fetchScreenRows(session, projectId, "position,hash", rows, outError)) return fail();
+        for (auto& row : rows) {
+            int pos = row.value("position", -1);
+            if (pos < 0) continue;
+            if (pos >= (int)remote.size()) remote.resize(pos + 1, 0);
+            remote[pos] = std::strtoull(row.value("hash", std::string()).c_str(), nullptr, 16);
+        }
+    }
+
+    // Upsert changed rows in batches, then drop rows past the end
+    std::vector<size_t> changed;
+    for (size_t i = 0; i < screens.size(); i++) {
+        if (i >= remote.size() || remote[i] != screenHashes[i]) changed.push_back(i);
+    }
+
+    // A split project on the server drops its hash before the first row
+    // changes, keeping its old row count. A save that stops part way then
+    // leaves a project no later save can take for "unchanged", even one
+    // of the old content.
+    if (!changed.empty() && remoteRows >= 0 && !remoteHash.empty()) {
+        data["screenRows"] = remoteRows;
+        if (!upsertProjectRow(session, projectName, data, projectId, nullptr, outError)) return fail();
+    }
+
+    std::vector<std::string> extraH = { "Prefer: resolution=merge-duplicates" };
+    std::string endpoint = "/rest/v1/project_screens?on_conflict=project_id,position";
+    ofJson batch = ofJson::array();
+    size_t uploaded = 0;
+    for (size_t i : changed) {
+        batch.push_back({
+            {"project_id", projectId},
+            {"position",   i},
+            {"hash",       Fnv1a::hex(screenHashes[i])},
+            {"data",       screens[i]},
+        });
+        if (batch.size() == ROWS_PER_REQUEST) {
+            ofJson resp;
+            if (!restRequest("POST", endpoint, session, extraH, batch.dump(), resp, outError)) {
+                return fail();
+            }
+            uploaded += batch.size();
+            batch = ofJson::array();
+        }
+    }
+    if (!batch.empty()) {
+        ofJson resp;
+        if (!restRequest("POST", endpoint, session, extraH, batch.dump(), resp, outError)) {
+            return fail();
+        }
+        uploaded += batch.size();
+    }
+
+    data["screenRows"] = screens.size();
+    data["contentHash"] = contentHash;
+    if (!upsertProjectRow(session, projectName, data, projectId, &outVersion, outError)) return fail();
+
+    // Rows past the end go last: until then loads ignore them, so a shrink
+    // that stops half way still reads back complete
+    bool trimmed = true;
+    if (remote.size() > screens.size()) {
+        ofJson resp;
+        std::string err;
+        std::string del = "/rest/v1/project_screens?project_id=eq." + projectId +
+                          "&position=gte." + ofToString(screens.size());
+        trimmed = restRequest("DELETE", del, session, {}, "", resp, err);
+        if (!trimmed) ofLogWarning("CloudStorage") << "Stale screen rows left for " << projectName << ": " << err;
+    }
+
+    {
+        // Without the trim, forget the row hashes so the next save reads
+        // them back and retries it
+        std::lock_guard<std::mutex> lock(syncMutex);
+        if (trimmed) {
+            synced[projectId] = { contentHash, screenHashes };
+        } else {
+            synced.erase(projectId);
+        }
+    }
+    ofLogNotice("CloudStorage") << "Saved " << projectName << ": " << uploaded << " of "
+                                << screens.size() << " screens uploaded";
+    return true;
+}
+
+bool CloudStorage::upsertProjectRow(const AuthManager::Session& session,
+                                     const std::string& projectName,
+                                     const ofJson& data,
+                                     std::string& outId,
+                                     std::string* outVersion,
+                                     std::string& outError) {
     ofJson body;
     body["name"] = projectName;
-    body["data"] = projectData;
+    body["data"] = data;
+    body["updated_at"] = "now"; // server clock; caches key on it
 
     // Upsert on (user_id, name) unique constraint
-    std::string endpoint = "/rest/v1/projects?on_conflict=user_id,name";
-    std::string extraH   = "-H \"Prefer: resolution=merge-duplicates\"";
+    std::string endpoint = "/rest/v1/projects?on_conflict=user_id,name&select=id,updated_at";
+    std::vector<std::string> extraH = { "Prefer: resolution=merge-duplicates,return=representation" };
 
     ofJson resp;
-    return restRequest("POST", endpoint, session, extraH, body.dump(), resp, outError);
+    if (!restRequest("POST", endpoint, session, extraH, body.dump(), resp, outError)) {
+        return false;
+    }
+    if (resp.is_array() && !resp.empty()) {
+        outId = resp[0].value("id", outId);
+        if (outVersion) *outVersion = resp[0].value("updated_at", std::string());
+    }
+    return true;
+}
+
+bool CloudStorage::fetchScreenRows(const AuthManager::Session& session,
+                                    const std::string& projectId,
+                                    const std::string& select,
+                                    ofJson& outRows,
+                                    std::string& outError) {
+    // Paged: PostgREST caps rows per response (max-rows)
+    outRows = ofJson::array();
+    while (true) {
+        std::string endpoint = "/rest/v1/project_screens?project_id=eq." + projectId +
+                               "&select=" + select + "&order=position" +
+                               "&limit=" + ofToString(ROWS_PER_REQUEST) +
+                               "&offset=" + ofToString(outRows.size());
+        ofJson resp;
+        if (!restRequest("GET", endpoint, session, {}, "", resp, outError)) {
+            return false;
+        }
+        if (!resp.is_array() || resp.empty()) return true;
+        for (auto& row : resp) outRows.push_back(std::move(row));
+    }
 }
 
 bool CloudStorage::loadProject(const AuthManager::Session& session,
                                 const std::string& projectId,
                                 ofJson& outData,
-                                std::string& outError) {
-    std::string endpoint = "/rest/v1/projects?id=eq." + projectId + "&select=data";
-
+                                std::string& outError,
+                                std::string* outVersion) {
+    std::string endpoint = "/rest/v1/projects?id=eq." + projectId;
     ofJson resp;
-    if (!restRequest("GET", endpoint, session, "", "", resp, outError)) {
+    ProjectCache& cache = cacheFor(session);
+
+    // Conditional fetch: compare updated_at before downloading the data
+    std::string cached = cache.version(projectId);
+    if (!cached.empty()) {
+        bool reached = restRequest("GET", endpoint + "&select=updated_at", session, {}, "", resp, outError);
+        bool current = reached && resp.is_array() && !resp.empty() &&
+                       resp[0].value("updated_at", std::string()) == cached;
+        if ((current || !reached) && cache.load(projectId, outData)) {
+            if (!reached) ofLogWarning("CloudStorage") << "Could not revalidate, opening cached copy: " << outError;
+            if (outVersion) *outVersion = cached;
+            outError.clear();
+            return true;
+        }
+        if (reached && (!resp.is_array() || resp.empty())) {
+            cache.remove(projectId); // deleted elsewhere
+            outError = "Project not found";
+            return false;
+        }
+    }
+
+    if (!restRequest("GET", endpoint + "&select=data,updated_at", session, {}, "", resp, outError)) {
         return false;
     }
 
@@ -190,16 +409,108 @@ bool CloudStorage::loadProject(const AuthManager::Session& session,
         return false;
     }
 
+    std::string updatedAt = resp[0].value("updated_at", std::string());
     outData = resp[0].value("data", ofJson());
+    if (!outData.is_object()) return true;
+    std::string contentHash = outData.value("contentHash", std::string());
+    outData.erase("contentHash");
+
+    if (outData.contains("screenRows")) {
+        size_t count = outData.value("screenRows", (size_t)0);
+        outData.erase("screenRows");
+
+        ofJson rows;
+        if (!fetchScreenRows(session, projectId, "position,hash,data", rows, outError)) {
+            return false;
+        }
+        SyncState state;
+        state.contentHash = contentHash;
+        state.screenHashes.assign(count, 0);
+        ofJson screens = ofJson::array();
+        for (size_t i = 0; i < count; i++) screens.push_back(nullptr);
+        size_t placed = 0;
+        for (auto& row : rows) {
+            int pos = row.value("position", -1);
+            if (pos < 0 || pos >= (int)count) continue; // stale row from an interrupted shrink
+            if (screens[pos].is_null()) placed++;
+            state.screenHashes[pos] = std::strtoull(row.value("hash", std::string()).c_str(), nullptr, 16);
+            screens[pos] = std::move(row["data"]);
+        }
+        // Every position 0..count-1 must be there, or the order is lost
+        if (placed != count) {
+            ofLogWarning("CloudStorage") << "Project " << projectId << " has " << placed << " of "
+                                         << count << " screen rows";
+            std::string cachedVersion = cache.version(projectId);
+            if (!cachedVersion.empty() && cache.load(projectId, outData)) {
+                if (outVersion) *outVersion = cachedVersion;
+                return true;
+            }
+            outError = "Project data is incomplete on the server";
+            return false;
+        }
+        outData["screens"] = std::move(screens);
+
+        std::lock_guard<std::mutex> lock(syncMutex);
+        synced[projectId] = std::move(state);
+    }
+
+    cache.store(projectId, updatedAt, outData);
+    if (outVersion) *outVersion = updatedAt;
     return true;
 }
 
+bool CloudStorage::loadCachedProject(const AuthManager::Session& session,
+                                      const std::string& projectId,
+                                      ofJson& outData,
+                                      std::string& outVersion) {
+    ProjectCache& cache = cacheFor(session);
+    outVersion = cache.version(projectId);
+    return !outVersion.empty() && cache.load(projectId, outData);
+}
+
+void CloudStorage::markOpened(const AuthManager::Session& session, const std::string& projectId) {
+    cacheFor(session).markOpened(projectId);
+}
+
+int CloudStorage::prefetchRecent(const AuthManager::Session& session, size_t count) {
+    std::vector<CloudProject> projects;
+    std::string err;
+    if (!listProjects(session, projects, err)) {
+        ofLogWarning("CloudStorage") << "Prefetch skipped: " << err;
+        return 0;
+    }
+
+    // Download only what the list says has moved on since it was cached
+    ProjectCache& cache = cacheFor(session);
+    int fetched = 0;
+    for (const auto& id : cache.recentlyOpened(count)) {
+        auto it = std::find_if(projects.begin(), projects.end(),
+                               [&](const CloudProject& p) { return p.id == id; });
+        if (it == projects.end()) {
+            cache.remove(id); // deleted elsewhere
+            continue;
+        }
+        if (it->updatedAt == cache.version(id)) continue;
+
+        ofJson data;
+        if (loadProject(session, id, data, err)) {
+            fetched++;
+        } else {
+            ofLogWarning("CloudStorage") << "Prefetch failed for " << it->name << ": " << err;
+        }
+    }
+    if (fetched > 0) ofLogNotice("CloudStorage") << "Prefetched " << fetched << " projects";
+    return fetched;
+}
+
 bool CloudStorage::deleteProject(const AuthManager::Session& session,
                                   const std::string& projectId,
                                   std::string& outError) {
     std::string endpoint = "/rest/v1/projects?id=eq." + projectId;
     ofJson resp;
-    return restRequest("DELETE", endpoint, session, "", "", resp, outError);
+    if (!restRequest("DELETE", endpoint, session, {}, "", resp, outError)) return false;
+    cacheFor(session).remove(projectId);
+    return true;
 }
 
 // ─── User preferences ───────────────────────────────────────────────────────
@@ -209,7 +520,7 @@ bool CloudStorage::loadPreferences(const AuthManager::Session& session,
                                     std::string& outError) {
     std::string endpoint = "/rest/v1/user_preferences?select=data";
     ofJson resp;
-    if (!restRequest("GET", endpoint, session, "", "", resp, outError)) {
+    if (!restRequest("GET", endpoint, session, {}, "", resp, outError)) {
         return false;
     }
 
@@ -230,7 +541,7 @@ bool CloudStorage::savePreferences(const AuthManager::Session& session,
     body["data"] = ofJson::parse(jsonData);
 
     std::string endpoint = "/rest/v1/user_preferences?on_conflict=user_id";
-    std::string extraH   = "-H \"Prefer: resolution=merge-duplicates\"";
+    std::vector<std::string> extraH = { "Prefer: resolution=merge-duplicates" };
 
     ofJson resp;
     return restRequest("POST", endpoint, session, extraH, body.dump(), resp, outError);
@@ -1,6 +1,12 @@
 #pragma once
 #include "ofMain.h"
 #include "AuthManager.h"
+#include "ProjectCache.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -20,6 +26,18 @@
 // ALTER TABLE projects ADD CONSTRAINT projects_user_name_key UNIQUE (user_id, name);
 // ALTER TABLE projects ENABLE ROW LEVEL SECURITY;
 // CREATE POLICY "Users own rows" ON projects FOR ALL USING (user_id = auth.uid());
+//
+// -- Screens of large projects, one row each (see saveProject)
+// CREATE TABLE project_screens (
+//   project_id uuid REFERENCES projects ON DELETE CASCADE NOT NULL,
+//   user_id    uuid REFERENCES auth.users NOT NULL DEFAULT auth.uid(),
+//   position   int  NOT NULL,
+//   hash       text NOT NULL,
+//   data       jsonb NOT NULL,
+//   PRIMARY KEY (project_id, position)
+// );
+// ALTER TABLE project_screens ENABLE ROW LEVEL SECURITY;
+// CREATE POLICY "Users own rows" ON project_screens FOR ALL USING (user_id = auth.uid());
 // ─────────────────────────────────────────────────────────────────────────────
 
 class CloudStorage {
@@ -30,22 +48,47 @@ public:
         std::string updatedAt;
     };
 
-    // List all projects for the logged-in user (blocking network call)
+    CloudStorage();
+
+    // List all projects for the logged-in user (blocking network call).
+    // The result is cached for listCachedProjects.
     bool listProjects(const AuthManager::Session& session,
                       std::vector<CloudProject>& outProjects,
                       std::string& outError);
 
-    // Upsert project JSON by name (blocking network call)
+    // Last fetched list, without network; false if never fetched
+    bool listCachedProjects(const AuthManager::Session& session,
+                            std::vector<CloudProject>& outProjects);
+
+    // Upsert project JSON by name (blocking network call).
+    // The stored data carries a content hash, so saving unchanged content is
+    // a single small lookup. Projects with SPLIT_SCREENS or more screens keep
+    // their screens as project_screens rows and only changed rows are sent.
     bool saveProject(const AuthManager::Session& session,
                      const ofJson& projectData,
                      const std::string& projectName,
                      std::string& outError);
 
-    // Load a project's data JSON by id (blocking network call)
+    // Load a project's data JSON by id, reassembling split projects
+    // (blocking network call). With a cached copy only updated_at is
+    // fetched, and the download is skipped when it still matches; offline,
+    // the cached copy is returned. outVersion receives the updated_at loaded.
     bool loadProject(const AuthManager::Session& session,
                      const std::string& projectId,
                      ofJson& outData,
-                     std::string& outError);
+                     std::string& outError,
+                     std::string* outVersion = nullptr);
+
+    // Cached copy only, no network (instant open). Empty version = none.
+    bool loadCachedProject(const AuthManager::Session& session, const std::string& projectId,
+                           ofJson& outData, std::string& outVersion);
+
+    // Record an open, for prefetchRecent
+    void markOpened(const AuthManager::Session& session, const std::string& projectId);
+
+    // Bring the cache up to date for the user's most recently opened
+    // projects (blocking network calls); returns how many were downloaded
+    int prefetchRecent(const AuthManager::Session& session, size_t count);
 
     // Delete a project by id (blocking network call)
     bool deleteProject(const AuthManager::Session& session,
@@ -64,16 +107,50 @@ public:
                          std::string& outError);
 
 private:
-    // Generic curl wrapper for Supabase REST (PostgREST)
-    // method: GET | POST | PATCH | DELETE
+    // Supabase REST (PostgREST) request through the shared HttpClient.
+    // method: GET | POST | PATCH | DELETE. False on network errors and
+    // non-2xx statuses (outError from the error body when there is one).
     bool restRequest(const std::string& method,
                      const std::string& endpoint,   // e.g. "/rest/v1/projects?..."
                      const AuthManager::Session& session,
-                     const std::string& extraHeaders,
+                     const std::vector<std::string>& extraHeaders, // "Name: value"
                      const std::string& jsonBody,   // empty for GET/DELETE
                      ofJson& outResponse,
                      std::string& outError);
 
-    std::string getTmpDir() const;
-    void ensureTmpDir() const;
+    // ── Delta sync ──────────────────────────────────────────────────────────
+    static constexpr size_t SPLIT_SCREENS    = 200;  // split projects at this size
+    static constexpr size_t ROWS_PER_REQUEST = 500;  // upsert batch / read page
+
+    // Per-screen content hashes the server holds for a split project, valid
+    // while its stored contentHash still matches
+    struct SyncState {
+        std::string contentHash;
+        std::vector<uint64_t> screenHashes; // by position
+    };
+
+    bool saveSplit(const AuthManager::Session& session, const std::string& projectName,
+                   std::string& projectId, const std::string& remoteHash, int remoteRows,
+                   const ofJson& meta, const ofJson& screens,
+                   const std::vector<uint64_t>& screenHashes,
+                   const std::string& contentHash, std::string& outVersion,
+                   std::string& outError);
+    // Upsert the projects row; returns its id and new updated_at
+    bool upsertProjectRow(const AuthManager::Session& session, const std::string& projectName,
+                          const ofJson& data, std::string& outId, std::string* outVersion,
+                          std::string& outError);
+    // All project_screens rows of a project (select = PostgREST column list)
+    bool fetchScreenRows(const AuthManager::Session& session, const std::string& projectId,
+                         const std::string& select, ofJson& outRows, std::string& outError);
+
+    // One cache per account (~/.virtualstage/cache/<userId>), so projects,
+    // lists and recently opened never mix between users on one machine
+    ProjectCache& cacheFor(const AuthManager::Session& session);
+    std::string cacheRoot;
+    std::map<std::string, std::unique_ptr<ProjectCache>> caches; // by user id
+    std::mutex cacheMutex;
+
+    std::map<std::string, SyncState> synced; // by project id
+    std::mutex syncMutex;
+    std::atomic<bool> screensTableMissing{false}; // table not created: never split
 };
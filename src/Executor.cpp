@@ -0,0 +1,113 @@
+#include "win_byte_fix.h"
+#include "Executor.h"
+#include <algorithm>
+
+Executor::Executor(int workerCount) {
+    for (int i = 0; i < std::max(1, workerCount); i++) {
+        workers.emplace_back(&Executor::workerLoop, this);
+    }
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+        for (auto& task : queue) task.token->cancelled = true;
+        queue.clear();
+        // Running work that polls its token (downloads) stops early
+        for (auto& c : categories) {
+            for (auto& token : c.second.running) token->cancelled = true;
+        }
+    }
+    cv.notify_all();
+    for (auto& w : workers) {
+        if (w.joinable()) w.join();
+    }
+}
+
+void Executor::setLimit(const std::string& category, int maxRunning, bool supersede) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& c = categories[category];
+    c.maxRunning = std::max(0, maxRunning);
+    c.supersede = supersede;
+}
+
+void Executor::enqueue(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto& c = categories[task.category];
+        if (c.supersede) {
+            // Queued ones are skipped when a worker reaches them; running
+            // ones finish but their completions are dropped
+            for (auto& queued : queue) {
+                if (queued.category == task.category) queued.token->cancelled = true;
+            }
+            for (auto& token : c.running) token->cancelled = true;
+        }
+        queue.push_back(std::move(task));
+    }
+    cv.notify_one();
+}
+
+std::deque<Executor::Task>::iterator Executor::findRunnable() {
+    // Oldest job whose category has room; cancelled jobs are taken at once
+    // (they only need retiring)
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        if (it->token->isCancelled()) return it;
+        const auto& c = categories[it->category];
+        if (c.maxRunning == 0 || (int)c.running.size() < c.maxRunning) return it;
+    }
+    return queue.end();
+}
+
+// ── Worker ──────────────────────────────────────────────────────────────────
+
+void Executor::workerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            auto it = queue.end();
+            cv.wait(lock, [&]() {
+                if (stopping) return true;
+                it = findRunnable();
+                return it != queue.end();
+            });
+            if (stopping) return;
+            task = std::move(*it);
+            queue.erase(it);
+            categories[task.category].running.push_back(task.token);
+        }
+
+        if (!task.token->isCancelled()) {
+            try {
+                task.run();
+            } catch (std::exception& e) {
+                ofLogError("Executor") << task.category << " job failed: " << e.what();
+                task.token->cancelled = true; // no result to complete with
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            auto& running = categories[task.category].running;
+            running.erase(std::find(running.begin(), running.end(), task.token));
+            finished.push_back(std::move(task));
+        }
+        cv.notify_all(); // a slot in the category opened
+    }
+}
+
+// ── Main thread ─────────────────────────────────────────────────────────────
+
+void Executor::drainCompletions() {
+    std::deque<Task> done;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        done.swap(finished);
+    }
+    for (auto& task : done) {
+        if (!task.token->isCancelled()) task.complete();
+        task.token->done = true;
+    }
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include "ofMain.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed pool of worker threads for blocking background work (network, disk).
+//
+// Work runs on a worker; its completion callback is queued and runs on the
+// main thread in drainCompletions(), which ofApp::update() calls once per
+// frame, so completions touch app state without locks. Each job belongs to a
+// category that can cap how many of its jobs run at once; in a superseding
+// category a new job cancels the ones already queued or running, so e.g.
+// back-to-back autosave uploads collapse to the newest.
+class Executor {
+public:
+    template <typename T> class Future;
+
+    // Shared by a job and its Future. Work may poll isCancelled() to stop early.
+    class CancelToken {
+    public:
+        bool isCancelled() const { return cancelled.load(); }
+
+    private:
+        friend class Executor;
+        template <typename T> friend class Future;
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> done{false}; // set on the main thread after completion
+    };
+
+    template <typename T>
+    class Future {
+    public:
+        bool isValid() const { return state != nullptr; }
+        // Finished and drained (cancelled jobs finish without a result)
+        bool isDone() const { return state && state->done.load(); }
+        bool isPending() const { return state && !state->done.load() && !state->isCancelled(); }
+        // A queued job never runs; a running one finishes, but its
+        // completion is dropped
+        void cancel() { if (state) state->cancelled = true; }
+        // Result — main thread, once isDone() and not cancelled
+        const T& get() const { return state->value; }
+
+    private:
+        friend class Executor;
+        struct State : CancelToken {
+            T value{};
+        };
+        std::shared_ptr<State> state;
+    };
+
+    explicit Executor(int workerCount = 4);
+    ~Executor(); // drops queued jobs, cancels and waits for running ones
+
+    // Category policy: at most maxRunning jobs at once (0 = no cap);
+    // supersede = a new job cancels the category's queued and running jobs
+    void setLimit(const std::string& category, int maxRunning, bool supersede = false);
+
+    // work(const CancelToken&) -> T runs on a worker;
+    // onComplete(const T&) runs on the main thread unless cancelled
+    template <typename Work, typename Done>
+    auto submit(const std::string& category, Work work, Done onComplete)
+        -> Future<std::invoke_result_t<Work, const CancelToken&>> {
+        using T = std::invoke_result_t<Work, const CancelToken&>;
+        static_assert(!std::is_void<T>::value, "return a result (e.g. bool) from background work");
+
+        Future<T> future;
+        future.state = std::make_shared<typename Future<T>::State>();
+        auto state = future.state;
+
+        Task task;
+        task.category = category;
+        task.token = state;
+        task.run = [state, work]() mutable { state->value = work(*state); };
+        task.complete = [state, onComplete]() mutable { onComplete(state->value); };
+        enqueue(std::move(task));
+        return future;
+    }
+
+    template <typename Work>
+    auto submit(const std::string& category, Work work)
+        -> Future<std::invoke_result_t<Work, const CancelToken&>> {
+        using T = std::invoke_result_t<Work, const CancelToken&>;
+        return submit(category, std::move(work), [](const T&) {});
+    }
+
+    // Run completions of finished jobs — main thread, once per frame
+    void drainCompletions();
+
+private:
+    struct Task {
+        std::string category;
+        std::shared_ptr<CancelToken> token;
+        std::function<void()> run;      // worker
+        std::function<void()> complete; // main thread
+    };
+
+    struct Category {
+        int maxRunning = 0;
+        bool supersede = false;
+        std::vector<std::shared_ptr<CancelToken>> running;
+    };
+
+    void enqueue(Task task);
+    void workerLoop();
+    std::deque<Task>::iterator findRunnable(); // under mtx
+
+    std::vector<std::thread> workers;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::deque<Task> queue;
+    std::deque<Task> finished;
+    std::map<std::string, Category> categories;
+};
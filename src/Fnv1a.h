@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// 64-bit FNV-1a. Unlike std::hash it is the same on every build and
+// platform, so it can name files on disk and be stored on the server.
+// Hashes chain: pass a previous result as 'h' to continue it.
+struct Fnv1a {
+    static constexpr uint64_t OFFSET = 1469598103934665603ULL;
+    static constexpr uint64_t PRIME  = 1099511628211ULL;
+
+    static uint64_t hash(const void* data, size_t size, uint64_t h = OFFSET) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            h ^= p[i];
+            h *= PRIME;
+        }
+        return h;
+    }
+
+    static uint64_t hash(const std::string& s, uint64_t h = OFFSET) {
+        return hash(s.data(), s.size(), h);
+    }
+
+    // Fold a whole 64-bit value in as one step (order matters)
+    static uint64_t combine(uint64_t h, uint64_t value) {
+        return (h ^ value) * PRIME;
+    }
+
+    // 16 lowercase hex digits
+    static std::string hex(uint64_t h) {
+        char buf[17];
+        snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)h);
+        return buf;
+    }
+};
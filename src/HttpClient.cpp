@@ -0,0 +1,265 @@
+#include "win_byte_fix.h"
+#include "HttpClient.h"
+#include "AppVersion.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+
+void HttpClient::init() {
+    get();
+}
+
+HttpClient& HttpClient::get() {
+    static HttpClient instance;
+    return instance;
+}
+
+HttpClient::HttpClient() {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    share = curl_share_init();
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, &HttpClient::lockShare);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, &HttpClient::unlockShare);
+    curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+HttpClient::~HttpClient() {
+    for (CURL* h : idle) curl_easy_cleanup(h);
+    idle.clear();
+    curl_share_cleanup(share);
+    curl_global_cleanup();
+}
+
+void HttpClient::lockShare(CURL*, curl_lock_data data, curl_lock_access, void* self) {
+    static_cast<HttpClient*>(self)->shareLocks[data].lock();
+}
+
+void HttpClient::unlockShare(CURL*, curl_lock_data data, void* self) {
+    static_cast<HttpClient*>(self)->shareLocks[data].unlock();
+}
+
+// ── Handle pool ─────────────────────────────────────────────────────────────
+
+CURL* HttpClient::acquireHandle() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (!idle.empty()) {
+            CURL* h = idle.back();
+            idle.pop_back();
+            return h;
+        }
+    }
+    return curl_easy_init();
+}
+
+void HttpClient::releaseHandle(CURL* handle) {
+    curl_easy_reset(handle); // clears options, keeps connections and sessions
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (idle.size() < MAX_IDLE) {
+        idle.push_back(handle);
+        return;
+    }
+    curl_easy_cleanup(handle);
+}
+
+// ── Requests ────────────────────────────────────────────────────────────────
+
+static size_t appendBody(char* data, size_t size, size_t count, void* out) {
+    static_cast<std::string*>(out)->append(data, size * count);
+    return size * count;
+}
+
+// Options shared by send() and download()
+void HttpClient::applyCommon(CURL* h, const Request& request, curl_slist* headers) {
+    curl_easy_setopt(h, CURLOPT_SHARE, share);
+    curl_easy_setopt(h, CURLOPT_URL, request.url.c_str());
+    curl_easy_setopt(h, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(h, CURLOPT_USERAGENT, "VirtualStage/" APP_VERSION);
+    curl_easy_setopt(h, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(h, CURLOPT_ACCEPT_ENCODING, ""); // any encoding curl can decode
+    curl_easy_setopt(h, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(h, CURLOPT_NOSIGNAL, 1L);        // required with worker threads
+    curl_easy_setopt(h, CURLOPT_TIMEOUT_MS, request.timeoutMs);
+    curl_easy_setopt(h, CURLOPT_CONNECTTIMEOUT_MS, request.connectTimeoutMs);
+#if defined(TARGET_WIN32) && defined(CURLSSLOPT_NATIVE_CA)
+    curl_easy_setopt(h, CURLOPT_SSL_OPTIONS, (long)CURLSSLOPT_NATIVE_CA); // Windows cert store
+#endif
+}
+
+HttpClient::Response HttpClient::send(const Request& request) {
+    Response response;
+    CURL* h = acquireHandle();
+    if (!h) {
+        response.error = "Could not create HTTP handle";
+        return response;
+    }
+
+    curl_slist* headers = nullptr;
+    for (const auto& header : request.headers) {
+        headers = curl_slist_append(headers, header.c_str());
+    }
+    // No "Expect: 100-continue" round trip before POST bodies
+    headers = curl_slist_append(headers, "Expect:");
+
+    applyCommon(h, request, headers);
+    curl_easy_setopt(h, CURLOPT_WRITEFUNCTION, &appendBody);
+    curl_easy_setopt(h, CURLOPT_WRITEDATA, &response.body);
+
+    if (request.method == "GET") {
+        curl_easy_setopt(h, CURLOPT_HTTPGET, 1L);
+    } else {
+        if (request.method != "POST") {
+            curl_easy_setopt(h, CURLOPT_CUSTOMREQUEST, request.method.c_str());
+        }
+        if (!request.body.empty() || request.method == "POST") {
+            curl_easy_setopt(h, CURLOPT_POSTFIELDS, request.body.data());
+            curl_easy_setopt(h, CURLOPT_POSTFIELDSIZE_LARGE, (curl_off_t)request.body.size());
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    CURLcode rc = curl_easy_perform(h);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - start).count();
+
+    if (rc == CURLE_OK) {
+        curl_easy_getinfo(h, CURLINFO_RESPONSE_CODE, &response.status);
+    } else {
+        response.error = curl_easy_strerror(rc);
+    }
+
+    ofLogVerbose("HttpClient") << request.method << " " << request.url << " -> "
+        << (response.status ? ofToString(response.status) : response.error)
+        << " in " << ms << " ms";
+
+    curl_slist_free_all(headers);
+    releaseHandle(h);
+    return response;
+}
+
+// ── Downloads ───────────────────────────────────────────────────────────────
+
+namespace {
+struct DownloadSink {
+    CURL* handle = nullptr;
+    const std::string* path = nullptr;
+    std::FILE* file = nullptr;
+    int64_t offset = 0;          // bytes already on disk when the request started
+    bool checked = false;        // status looked at (first write)
+    bool toFile = false;         // 200/206: body goes to the file
+    std::string errorBody;       // anything else: kept for the caller
+    const HttpClient::Progress* progress = nullptr;
+};
+}
+
+static size_t writeDownload(char* data, size_t size, size_t count, void* userp) {
+    auto* sink = static_cast<DownloadSink*>(userp);
+    size_t n = size * count;
+    if (!sink->checked) {
+        sink->checked = true;
+        long status = 0;
+        curl_easy_getinfo(sink->handle, CURLINFO_RESPONSE_CODE, &status);
+        if (status == 200 && sink->offset > 0) {
+            // Range ignored: the whole file is coming, start over
+            std::fclose(sink->file);
+            sink->file = std::fopen(sink->path->c_str(), "wb");
+            sink->offset = 0;
+        }
+        sink->toFile = (status == 200 || status == 206) && sink->file;
+    }
+    if (!sink->toFile) {
+        sink->errorBody.append(data, n);
+        return n;
+    }
+    return std::fwrite(data, 1, n, sink->file);
+}
+
+static int downloadProgress(void* userp, curl_off_t total, curl_off_t now, curl_off_t, curl_off_t) {
+    auto* sink = static_cast<DownloadSink*>(userp);
+    if (!sink->progress || !*sink->progress) return 0;
+    int64_t received = sink->offset + (int64_t)now;
+    int64_t expected = total > 0 ? sink->offset + (int64_t)total : -1;
+    return (*sink->progress)(received, expected) ? 0 : 1; // non-zero aborts
+}
+
+HttpClient::Response HttpClient::download(const Request& request, const std::string& path,
+                                          const Progress& progress) {
+    Response response;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        std::FILE* file = std::fopen(path.c_str(), "ab");
+        if (!file) {
+            response.error = "Cannot write " + path;
+            return response;
+        }
+        // Not ftell: its long is 32 bits on Windows, and updates can pass 2 GiB
+        std::error_code ec;
+        uintmax_t onDisk = std::filesystem::file_size(path, ec);
+        int64_t offset = ec ? 0 : (int64_t)onDisk;
+
+        CURL* h = acquireHandle();
+        if (!h) {
+            std::fclose(file);
+            response.error = "Could not create HTTP handle";
+            return response;
+        }
+
+        curl_slist* headers = nullptr;
+        for (const auto& header : request.headers) {
+            headers = curl_slist_append(headers, header.c_str());
+        }
+        // A plain header rather than CURLOPT_RESUME_FROM, which fails outright
+        // when the server ignores it; writeDownload restarts on a 200 instead
+        if (offset > 0) {
+            headers = curl_slist_append(headers, ("Range: bytes=" + ofToString(offset) + "-").c_str());
+        }
+
+        DownloadSink sink;
+        sink.handle = h;
+        sink.path = &path;
+        sink.file = file;
+        sink.offset = offset;
+        sink.progress = &progress;
+
+        applyCommon(h, request, headers);
+        curl_easy_setopt(h, CURLOPT_HTTPGET, 1L);
+        curl_easy_setopt(h, CURLOPT_ACCEPT_ENCODING, nullptr); // byte ranges of the file as stored
+        curl_easy_setopt(h, CURLOPT_WRITEFUNCTION, &writeDownload);
+        curl_easy_setopt(h, CURLOPT_WRITEDATA, &sink);
+        curl_easy_setopt(h, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(h, CURLOPT_XFERINFOFUNCTION, &downloadProgress);
+        curl_easy_setopt(h, CURLOPT_XFERINFODATA, &sink);
+        // Big files: no overall deadline, but give up on a stalled transfer
+        curl_easy_setopt(h, CURLOPT_LOW_SPEED_LIMIT, 1L);
+        curl_easy_setopt(h, CURLOPT_LOW_SPEED_TIME, 30L);
+
+        auto start = std::chrono::steady_clock::now();
+        CURLcode rc = curl_easy_perform(h);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start).count();
+
+        response.status = 0;
+        response.error.clear();
+        if (rc == CURLE_OK) {
+            curl_easy_getinfo(h, CURLINFO_RESPONSE_CODE, &response.status);
+        } else {
+            response.error = curl_easy_strerror(rc); // partial file stays for resuming
+        }
+        response.body = sink.errorBody;
+        if (sink.file) std::fclose(sink.file);
+        curl_slist_free_all(headers);
+        releaseHandle(h);
+
+        ofLogVerbose("HttpClient") << "GET " << request.url << " -> "
+            << (response.status ? ofToString(response.status) : response.error)
+            << " from byte " << offset << " in " << ms << " ms";
+
+        // Range past the end (file changed or already complete): start over once
+        if (response.status == 416 && offset > 0 && attempt == 0) {
+            std::remove(path.c_str());
+            continue;
+        }
+        break;
+    }
+    return response;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "ofMain.h"
+#include <curl/curl.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <mutex>
+
+// In-process HTTP(S) over libcurl, shared by AuthManager, CloudStorage and
+// the updater. send() keeps bodies in memory; download() streams to disk.
+//
+// Easy handles are pooled, and each keeps its own connections between
+// requests, so back-to-back calls to the same host reuse a warm connection
+// instead of paying a new TCP + TLS handshake each time. All of them share
+// one curl_share for DNS and TLS sessions; the connection cache is not
+// shared, since libcurl does not support that across concurrent threads.
+// Calls are blocking and safe to make from several threads at once.
+class HttpClient {
+public:
+    struct Request {
+        std::string method = "GET"; // GET | POST | PATCH | DELETE | ...
+        std::string url;
+        std::vector<std::string> headers; // "Name: value"
+        std::string body;                 // sent when non-empty
+        long timeoutMs = 30000;           // whole transfer (0 = none)
+        long connectTimeoutMs = 10000;
+    };
+
+    struct Response {
+        long status = 0;   // HTTP status; 0 = no response (see error)
+        std::string body;
+        std::string error; // transport error (DNS, connect, TLS, timeout)
+
+        bool ok() const { return status >= 200 && status < 300; }
+    };
+
+    // (received, total) in bytes, total -1 if unknown; return false to abort
+    using Progress = std::function<bool(int64_t received, int64_t total)>;
+
+    // curl_global_init is not thread-safe: main() calls init() on the main
+    // thread before anything can reach get() from a worker
+    static void init();
+    static HttpClient& get();
+
+    Response send(const Request& request);
+
+    // GET streamed to a file. If the file already holds part of the body the
+    // request asks for the rest with a Range header (and starts over if the
+    // server sends the whole file instead). The file is left in place on
+    // failure so the next call resumes. Non-2xx bodies go to response.body,
+    // not the file. progress runs on the calling thread.
+    Response download(const Request& request, const std::string& path,
+                      const Progress& progress = Progress());
+
+private:
+    HttpClient();
+    ~HttpClient();
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    void applyCommon(CURL* handle, const Request& request, curl_slist* headers);
+    CURL* acquireHandle();
+    void releaseHandle(CURL* handle);
+
+    static void lockShare(CURL*, curl_lock_data data, curl_lock_access, void* self);
+    static void unlockShare(CURL*, curl_lock_data data, void* self);
+
+    CURLSH* share = nullptr;
+    std::mutex shareLocks[CURL_LOCK_DATA_LAST];
+
+    std::mutex poolMutex;
+    std::vector<CURL*> idle; // reset between requests; keeps its connections
+    static constexpr size_t MAX_IDLE = 8;
+};
@@ -0,0 +1,281 @@
+#include "win_byte_fix.h"
+#include "MaskCache.h"
+#include "Fnv1a.h"
+#include "ProjectFile.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+static const int SUBSAMPLES = 4; // scanlines per pixel row (vertical AA)
+
+// Disk layout, one file per mask: <contour hash>-<w>x<h>.mask
+//   "VSTGMASK"   (8 bytes magic)
+//   uint32 LE    format version
+//   uint32 LE    width, height, contour point count
+//   uint32 LE    contour x, y float bits (the exact key, for hash collisions)
+//   coverage     row-major runs of (uint8 length 1-255, uint8 value)
+static const char MAGIC[8] = { 'V', 'S', 'T', 'G', 'M', 'A', 'S', 'K' };
+static const size_t HEADER_SIZE = 24;
+
+static void putU32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; i++) out.push_back((char)((v >> (i * 8)) & 0xff));
+}
+
+static uint32_t getU32(const std::string& in, size_t offset) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= (uint32_t)(uint8_t)in[offset + i] << (i * 8);
+    return v;
+}
+
+static uint32_t floatBits(float f) {
+    uint32_t v;
+    memcpy(&v, &f, sizeof(v));
+    return v;
+}
+
+// Masks are mostly empty or full, so runs keep the files a few KB
+static std::string encodeMask(const std::vector<glm::vec2>& contour, const ofPixels& pixels) {
+    std::string out(MAGIC, sizeof(MAGIC));
+    putU32(out, MaskCache::FILE_VERSION);
+    putU32(out, (uint32_t)pixels.getWidth());
+    putU32(out, (uint32_t)pixels.getHeight());
+    putU32(out, (uint32_t)contour.size());
+    for (auto& p : contour) {
+        putU32(out, floatBits(p.x));
+        putU32(out, floatBits(p.y));
+    }
+
+    const unsigned char* data = pixels.getData();
+    size_t n = pixels.getWidth() * pixels.getHeight();
+    for (size_t i = 0; i < n;) {
+        size_t run = 1;
+        while (i + run < n && run < 255 && data[i + run] == data[i]) run++;
+        out.push_back((char)run);
+        out.push_back((char)data[i]);
+        i += run;
+    }
+    return out;
+}
+
+// Even-odd scanline fill with fractional horizontal coverage, so edges come
+// out antialiased and the linear-filtered texture stays smooth when magnified
+static void rasterize(const std::vector<glm::vec2>& contour, ofPixels& out) {
+    int w = (int)out.getWidth();
+    int h = (int)out.getHeight();
+    std::vector<float> coverage(w);
+    std::vector<float> xs;
+    size_t n = contour.size();
+
+    for (int y = 0; y < h; y++) {
+        std::fill(coverage.begin(), coverage.end(), 0.0f);
+        for (int sub = 0; sub < SUBSAMPLES; sub++) {
+            float sy = (y + (sub + 0.5f) / SUBSAMPLES) / h;
+
+            xs.clear();
+            for (size_t i = 0, j = n - 1; i < n; j = i++) {
+                const glm::vec2& a = contour[i];
+                const glm::vec2& b = contour[j];
+                if ((a.y <= sy) != (b.y <= sy)) {
+                    xs.push_back((a.x + (sy - a.y) * (b.x - a.x) / (b.y - a.y)) * w);
+                }
+            }
+            std::sort(xs.begin(), xs.end());
+
+            for (size_t k = 0; k + 1 < xs.size(); k += 2) {
+                float x0 = ofClamp(xs[k], 0, (float)w);
+                float x1 = ofClamp(xs[k + 1], 0, (float)w);
+                if (x1 <= x0) continue;
+                int p0 = (int)x0;
+                int p1 = std::min((int)x1, w - 1);
+                if (p0 == p1) {
+                    coverage[p0] += x1 - x0;
+                    continue;
+                }
+                coverage[p0] += (p0 + 1) - x0;
+                for (int p = p0 + 1; p < p1; p++) coverage[p] += 1.0f;
+                coverage[p1] += x1 - p1;
+            }
+        }
+
+        unsigned char* row = out.getData() + (size_t)y * w;
+        for (int x = 0; x < w; x++) {
+            row[x] = (unsigned char)(std::min(1.0f, coverage[x] / SUBSAMPLES) * 255.0f + 0.5f);
+        }
+    }
+}
+
+// --- Mask ---
+
+const ofTexture& MaskCache::Mask::getTexture() {
+    if (!texture.isAllocated()) {
+        // GL_TEXTURE_2D so the shader samples with the screen's 0-1 UVs
+        texture.allocate(pixels, false);
+        texture.loadData(pixels);
+        texture.setTextureMinMagFilter(GL_LINEAR, GL_LINEAR);
+        texture.setTextureWrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+        pixels.clear();
+    }
+    return texture;
+}
+
+// --- MaskCache ---
+
+MaskCache::MaskCache()
+    : diskDir(ofFilePath::join(ofFilePath::getUserHomeDir(), ".virtualstage/masks")) {}
+
+MaskCache& MaskCache::get() {
+    static MaskCache instance;
+    return instance;
+}
+
+std::shared_ptr<MaskCache::Mask> MaskCache::acquire(const std::vector<glm::vec2>& contour, float aspect) {
+    if (contour.size() < 3) return nullptr;
+
+    // Texture size follows the screen's aspect so texels stay roughly square
+    int w = RESOLUTION, h = RESOLUTION;
+    if (aspect >= 1.0f) {
+        h = std::max(MIN_SIDE, (int)(RESOLUTION / aspect + 0.5f));
+    } else if (aspect > 0.0f) {
+        w = std::max(MIN_SIDE, (int)(RESOLUTION * aspect + 0.5f));
+    }
+
+    uint64_t hash = Fnv1a::hash(contour.data(), contour.size() * sizeof(glm::vec2)); // float bits
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto range = entries.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            const Entry& e = it->second;
+            if (e.width != w || e.height != h || e.contour != contour) continue;
+            if (auto shared = e.mask.lock()) return shared;
+        }
+    }
+
+    // Miss: read it back from disk, or rasterize it, without holding the lock.
+    // A new mask is encoded now, since once shared its pixels are released
+    // on upload.
+    auto mask = std::make_shared<Mask>();
+    mask->width = w;
+    mask->height = h;
+    mask->pixels.allocate(w, h, OF_PIXELS_GRAY);
+    std::string path = pathFor(hash, w, h);
+    std::string bytes;
+    if (!loadFromDisk(path, contour, mask->pixels)) {
+        rasterize(contour, mask->pixels);
+        bytes = encodeMask(contour, mask->pixels);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (auto shared = insert(hash, contour, mask)) return shared;
+    }
+    if (!bytes.empty()) storeToDisk(path, bytes);
+    return mask;
+}
+
+std::shared_ptr<MaskCache::Mask> MaskCache::insert(uint64_t hash, const std::vector<glm::vec2>& contour,
+                                                   const std::shared_ptr<Mask>& mask) {
+    int w = mask->width;
+    int h = mask->height;
+    auto range = entries.equal_range(hash);
+    for (auto it = range.first; it != range.second;) {
+        Entry& e = it->second;
+        if (e.width == w && e.height == h && e.contour == contour) {
+            // Another worker rasterized the same mask meanwhile
+            if (auto shared = e.mask.lock()) return shared;
+            it = entries.erase(it);
+            continue;
+        }
+        if (e.mask.expired()) {
+            it = entries.erase(it);
+            continue;
+        }
+        ++it;
+    }
+    Entry e;
+    e.contour = contour;
+    e.width = w;
+    e.height = h;
+    e.mask = mask;
+    entries.emplace(hash, std::move(e));
+    return nullptr;
+}
+
+size_t MaskCache::getMaskCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    size_t live = 0;
+    for (auto& kv : entries) {
+        if (!kv.second.mask.expired()) live++;
+    }
+    return live;
+}
+
+// --- Disk store ---
+
+std::string MaskCache::pathFor(uint64_t hash, int w, int h) const {
+    return ofFilePath::join(diskDir, Fnv1a::hex(hash) + "-" + ofToString(w) + "x" + ofToString(h) + ".mask");
+}
+
+bool MaskCache::loadFromDisk(const std::string& path, const std::vector<glm::vec2>& contour, ofPixels& pixels) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    size_t w = pixels.getWidth();
+    size_t h = pixels.getHeight();
+    size_t offset = HEADER_SIZE + contour.size() * 8;
+    if (bytes.size() < offset || memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+        getU32(bytes, 8) != FILE_VERSION || getU32(bytes, 12) != w || getU32(bytes, 16) != h ||
+        getU32(bytes, 20) != contour.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < contour.size(); i++) {
+        if (getU32(bytes, HEADER_SIZE + i * 8) != floatBits(contour[i].x) ||
+            getU32(bytes, HEADER_SIZE + i * 8 + 4) != floatBits(contour[i].y)) {
+            return false; // another contour with the same hash
+        }
+    }
+
+    unsigned char* data = pixels.getData();
+    size_t n = w * h, filled = 0;
+    for (; offset + 1 < bytes.size() && filled < n; offset += 2) {
+        size_t run = (uint8_t)bytes[offset];
+        if (run == 0 || filled + run > n) return false;
+        memset(data + filled, (uint8_t)bytes[offset + 1], run);
+        filled += run;
+    }
+    if (filled != n || offset != bytes.size()) return false; // torn or padded
+
+    // Keep recently used masks from being evicted
+    std::error_code ec;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    return true;
+}
+
+void MaskCache::storeToDisk(const std::string& path, const std::string& bytes) {
+    std::call_once(diskEvicted, [this]() { evictDisk(); });
+    std::error_code ec;
+    std::filesystem::create_directories(diskDir, ec);
+    if (!ProjectFile::writeAtomically(path, bytes)) {
+        ofLogWarning("MaskCache") << "Could not store mask: " << path;
+    }
+}
+
+void MaskCache::evictDisk() {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    std::vector<std::pair<fs::file_time_type, fs::path>> files;
+    for (fs::directory_iterator it(diskDir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() != ".mask") continue;
+        files.emplace_back(it->last_write_time(ec), it->path());
+    }
+    if (files.size() <= MAX_DISK_MASKS) return;
+
+    // Oldest first; keep room for this run's new masks
+    std::sort(files.begin(), files.end());
+    size_t drop = files.size() - MAX_DISK_MASKS / 2;
+    for (size_t i = 0; i < drop; i++) fs::remove(files[i].second, ec);
+    ofLogNotice("MaskCache") << "Evicted " << drop << " stored masks";
+}
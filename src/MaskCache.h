@@ -0,0 +1,80 @@
+#pragma once
+#include "ofMain.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+// Process-wide cache of rasterized polygon masks.
+// A mask contour (normalized 0-1, V down) is filled even-odd into a small
+// alpha texture in the screen's UV space; ScreenShader multiplies it into
+// the fragment alpha, so the same mask clips flat and curved screens alike
+// and drawing cost does not depend on the number of contour points.
+//
+// Screens with the same contour and texture size share one Mask. The cache
+// holds weak references, so a mask is freed with the last screen using it.
+//
+// Rasterized coverage is also kept under ~/.virtualstage/masks, one file
+// per contour and size, so reopening a large project reads its masks back
+// instead of filling every contour again. The least recently used files go
+// once there are more than MAX_DISK_MASKS.
+class MaskCache {
+public:
+    class Mask {
+    public:
+        // Uploads on first use — main (GL) thread only
+        const ofTexture& getTexture();
+        int getWidth() const { return width; }
+        int getHeight() const { return height; }
+
+    private:
+        friend class MaskCache;
+        int width = 0;
+        int height = 0;
+        ofPixels pixels; // coverage, released after upload
+        ofTexture texture;
+    };
+
+    static MaskCache& get();
+
+    // Rasterize (or share) a mask for a screen of the given aspect
+    // (width / height). Safe to call from Scene's load workers.
+    std::shared_ptr<Mask> acquire(const std::vector<glm::vec2>& contour, float aspect);
+
+    size_t getMaskCount();
+
+    // Longest texture side; the other side follows the screen's aspect
+    static constexpr int RESOLUTION = 512;
+    static constexpr int MIN_SIDE = 32;
+
+    static constexpr size_t MAX_DISK_MASKS = 2048;
+    static const uint32_t FILE_VERSION = 1;
+
+private:
+    MaskCache();
+
+    // Under mtx: add a new mask, or return the one another worker added
+    // for the same contour meanwhile
+    std::shared_ptr<Mask> insert(uint64_t hash, const std::vector<glm::vec2>& contour,
+                                 const std::shared_ptr<Mask>& mask);
+
+    // Disk store — any thread; a file that does not match is ignored
+    std::string pathFor(uint64_t hash, int w, int h) const;
+    bool loadFromDisk(const std::string& path, const std::vector<glm::vec2>& contour, ofPixels& pixels);
+    void storeToDisk(const std::string& path, const std::string& bytes);
+    void evictDisk();
+
+    struct Entry {
+        std::vector<glm::vec2> contour; // exact key (hash collisions)
+        int width = 0;
+        int height = 0;
+        std::weak_ptr<Mask> mask;
+    };
+    std::unordered_multimap<uint64_t, Entry> entries;
+    std::mutex mtx;
+
+    std::string diskDir;
+    std::once_flag diskEvicted; // trimmed once per run, on the first store
+};
@@ -0,0 +1,78 @@
+#include "win_byte_fix.h"
+#include "MeshPool.h"
+
+// --- Mesh ---
+
+void MeshPool::Mesh::draw() const {
+    vbo.drawElements(GL_TRIANGLES, indexCount);
+}
+
+// --- MeshPool ---
+
+MeshPool& MeshPool::get() {
+    static MeshPool instance;
+    return instance;
+}
+
+MeshPool::Handle MeshPool::acquire(int cols, int rows) {
+    auto key = std::make_pair(cols, rows);
+    auto it = meshes.find(key);
+    if (it != meshes.end()) {
+        if (auto shared = it->second.lock()) {
+            hits++;
+            return shared;
+        }
+    }
+    misses++;
+
+    // Drop grids whose last handle has gone, so the map only holds live LODs
+    for (auto e = meshes.begin(); e != meshes.end();) {
+        e = e->second.expired() ? meshes.erase(e) : std::next(e);
+    }
+
+    std::vector<glm::vec3> verts;
+    std::vector<glm::vec2> uvs;
+    std::vector<ofIndexType> indices;
+    for (int j = 0; j <= rows; j++) {
+        float s = (float)j / rows;       // 0 = bottom
+        for (int i = 0; i <= cols; i++) {
+            float t = (float)i / cols;
+            verts.push_back(glm::vec3(t - 0.5f, s - 0.5f, 0));
+            uvs.push_back(glm::vec2(t, 1.0f - s)); // V=0 at the top
+        }
+    }
+    for (int j = 0; j < rows; j++) {
+        for (int i = 0; i < cols; i++) {
+            ofIndexType bl = j * (cols + 1) + i;
+            ofIndexType br = bl + 1;
+            ofIndexType tl = bl + (cols + 1);
+            ofIndexType tr = tl + 1;
+            indices.insert(indices.end(), { bl, tl, br, br, tl, tr });
+        }
+    }
+
+    auto mesh = std::make_shared<Mesh>();
+    mesh->vbo.setVertexData(verts.data(), (int)verts.size(), GL_STATIC_DRAW);
+    mesh->vbo.setTexCoordData(uvs.data(), (int)uvs.size(), GL_STATIC_DRAW);
+    mesh->vbo.setIndexData(indices.data(), (int)indices.size(), GL_STATIC_DRAW);
+    mesh->cols = cols;
+    mesh->rows = rows;
+    mesh->indexCount = (int)indices.size();
+    mesh->bytes = verts.size() * sizeof(glm::vec3) + uvs.size() * sizeof(glm::vec2) +
+                  indices.size() * sizeof(ofIndexType);
+    meshes[key] = mesh;
+    return mesh;
+}
+
+MeshPool::Stats MeshPool::getStats() const {
+    Stats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    for (auto& kv : meshes) {
+        if (auto mesh = kv.second.lock()) {
+            stats.meshes++;
+            stats.gpuBytes += mesh->getGpuBytes();
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "ofMain.h"
+#include <map>
+#include <memory>
+#include <utility>
+
+// Process-wide pool of screen grid meshes.
+// Every screen is drawn from a unit grid over -0.5..0.5 (UV 0-1, V=0 at the
+// top) that ScreenShader scales, bends and masks per screen, so geometry is
+// keyed by grid resolution only: all screens at the same LOD share one
+// VBO/IBO and keep just a handle. A grid is freed when its last handle goes.
+//
+// Handles must be acquired and released on the main (GL) thread.
+class MeshPool {
+public:
+    class Mesh {
+    public:
+        void draw() const;
+        int getColumns() const { return cols; }
+        int getRows() const { return rows; }
+        size_t getGpuBytes() const { return bytes; }
+
+    private:
+        friend class MeshPool;
+        mutable ofVbo vbo;
+        int cols = 0;
+        int rows = 0;
+        int indexCount = 0;
+        size_t bytes = 0;
+    };
+    using Handle = std::shared_ptr<const Mesh>;
+
+    struct Stats {
+        int meshes = 0;        // live grids
+        size_t gpuBytes = 0;   // vertex + index data of live grids
+        size_t hits = 0;       // acquires served by an existing grid
+        size_t misses = 0;     // acquires that built a grid
+        float hitRate() const { return (hits + misses) ? (float)hits / (hits + misses) : 0.0f; }
+    };
+
+    static MeshPool& get();
+
+    Handle acquire(int cols, int rows);
+    Stats getStats() const;
+
+private:
+    MeshPool() = default;
+
+    std::map<std::pair<int, int>, std::weak_ptr<const Mesh>> meshes;
+    size_t hits = 0;
+    size_t misses = 0;
+};
@@ -0,0 +1,169 @@
+#include "win_byte_fix.h"
+#include "ProjectCache.h"
+#include "ProjectFile.h"
+#include "Fnv1a.h"
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+
+ProjectCache::ProjectCache(const std::string& dir) : dir(dir) {}
+
+std::string ProjectCache::pathFor(const std::string& file) const {
+    return ofFilePath::join(dir, file);
+}
+
+// ── Index ───────────────────────────────────────────────────────────────────
+
+void ProjectCache::loadIndex() {
+    if (indexLoaded) return;
+    indexLoaded = true;
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+
+    std::ifstream in(pathFor("index.json"));
+    if (!in) return;
+    try {
+        ofJson j = ofJson::parse(in);
+        for (auto it = j.begin(); it != j.end(); ++it) {
+            Entry e;
+            e.updatedAt = it.value().value("updatedAt", std::string());
+            e.file      = it.value().value("file", std::string());
+            e.openedAt  = it.value().value("openedAt", 0LL);
+            index[it.key()] = e;
+        }
+    } catch (std::exception& e) {
+        ofLogWarning("ProjectCache") << "Ignoring unreadable index: " << e.what();
+    }
+}
+
+void ProjectCache::saveIndex() {
+    ofJson j = ofJson::object();
+    for (auto& kv : index) {
+        j[kv.first] = {
+            {"updatedAt", kv.second.updatedAt},
+            {"file",      kv.second.file},
+            {"openedAt",  kv.second.openedAt},
+        };
+    }
+    ProjectFile::writeAtomically(pathFor("index.json"), j.dump());
+}
+
+void ProjectCache::evict() {
+    size_t stored = 0;
+    for (auto& kv : index) {
+        if (!kv.second.file.empty()) stored++;
+    }
+    while (stored > MAX_PROJECTS) {
+        auto oldest = index.end();
+        for (auto it = index.begin(); it != index.end(); ++it) {
+            if (it->second.file.empty()) continue;
+            if (oldest == index.end() || it->second.openedAt < oldest->second.openedAt) oldest = it;
+        }
+        std::error_code ec;
+        std::filesystem::remove(pathFor(oldest->second.file), ec);
+        oldest->second.file.clear();
+        oldest->second.updatedAt.clear();
+        stored--;
+    }
+}
+
+// ── Projects ────────────────────────────────────────────────────────────────
+
+std::string ProjectCache::version(const std::string& projectId) {
+    std::lock_guard<std::mutex> lock(mtx);
+    loadIndex();
+    auto it = index.find(projectId);
+    return it != index.end() && !it->second.file.empty() ? it->second.updatedAt : std::string();
+}
+
+bool ProjectCache::load(const std::string& projectId, ofJson& outData) {
+    std::string file;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        loadIndex();
+        auto it = index.find(projectId);
+        if (it == index.end() || it->second.file.empty()) return false;
+        file = it->second.file;
+    }
+    // Read outside the lock; a concurrent store of a newer version only
+    // makes this miss, and the caller falls back to the network
+    return ProjectFile::load(pathFor(file), outData);
+}
+
+void ProjectCache::store(const std::string& projectId, const std::string& updatedAt,
+                         const ofJson& data) {
+    // Each version gets its own file name
+    std::string tag = Fnv1a::hex(Fnv1a::hash(updatedAt));
+    std::string file = projectId + "-" + tag + ProjectFile::BINARY_EXTENSION;
+    std::string bytes = ProjectFile::encode(data, ProjectFile::Format::Binary);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    loadIndex();
+    if (!ProjectFile::writeAtomically(pathFor(file), bytes)) return;
+
+    Entry& e = index[projectId];
+    if (!e.file.empty() && e.file != file) {
+        std::error_code ec;
+        std::filesystem::remove(pathFor(e.file), ec); // superseded version
+    }
+    e.updatedAt = updatedAt;
+    e.file = file;
+    evict();
+    saveIndex();
+}
+
+void ProjectCache::remove(const std::string& projectId) {
+    std::lock_guard<std::mutex> lock(mtx);
+    loadIndex();
+    auto it = index.find(projectId);
+    if (it == index.end()) return;
+    std::error_code ec;
+    if (!it->second.file.empty()) std::filesystem::remove(pathFor(it->second.file), ec);
+    index.erase(it);
+    saveIndex();
+}
+
+void ProjectCache::markOpened(const std::string& projectId) {
+    std::lock_guard<std::mutex> lock(mtx);
+    loadIndex();
+    index[projectId].openedAt = (long long)std::time(nullptr);
+    saveIndex();
+}
+
+std::vector<std::string> ProjectCache::recentlyOpened(size_t count) {
+    std::vector<std::pair<long long, std::string>> opened;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        loadIndex();
+        for (auto& kv : index) {
+            if (kv.second.openedAt > 0) opened.push_back({ kv.second.openedAt, kv.first });
+        }
+    }
+    std::sort(opened.begin(), opened.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < opened.size() && i < count; i++) ids.push_back(opened[i].second);
+    return ids;
+}
+
+// ── Project list ────────────────────────────────────────────────────────────
+
+void ProjectCache::storeList(const ofJson& list) {
+    std::lock_guard<std::mutex> lock(mtx);
+    loadIndex(); // creates the directory
+    ProjectFile::writeAtomically(pathFor("list.json"), list.dump());
+}
+
+bool ProjectCache::loadList(ofJson& outList) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::ifstream in(pathFor("list.json"));
+    if (!in) return false;
+    try {
+        outList = ofJson::parse(in);
+    } catch (...) {
+        return false;
+    }
+    return outList.is_array();
+}
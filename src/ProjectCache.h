@@ -0,0 +1,56 @@
+#pragma once
+#include "ofMain.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Local copies of one user's cloud projects under
+// ~/.virtualstage/cache/<userId>, so a project opens at once (and offline)
+// and is only downloaded again when the server's updated_at has moved on.
+//
+//   <id>-<version>.vstage   project data (ProjectFile binary); the name is
+//                           derived from id + updated_at, one version kept
+//   index.json              id -> { updatedAt, file, openedAt }
+//   list.json               last fetched project list, for offline browsing
+//
+// Safe to use from several threads.
+class ProjectCache {
+public:
+    explicit ProjectCache(const std::string& dir);
+
+    // updated_at of the cached copy; empty when the project is not cached
+    std::string version(const std::string& projectId);
+
+    bool load(const std::string& projectId, ofJson& outData);
+    void store(const std::string& projectId, const std::string& updatedAt, const ofJson& data);
+    void remove(const std::string& projectId);
+
+    // Most recently opened first, for prefetching
+    void markOpened(const std::string& projectId);
+    std::vector<std::string> recentlyOpened(size_t count);
+
+    void storeList(const ofJson& list);
+    bool loadList(ofJson& outList);
+
+private:
+    struct Entry {
+        std::string updatedAt;
+        std::string file;      // empty until stored
+        long long openedAt = 0;
+    };
+
+    static constexpr size_t MAX_PROJECTS = 32; // least recently opened go first
+
+    // Under mtx
+    void loadIndex();
+    void saveIndex();
+    void evict();
+
+    std::string pathFor(const std::string& file) const;
+
+    std::string dir;
+    std::mutex mtx;
+    std::map<std::string, Entry> index;
+    bool indexLoaded = false;
+};
@@ -0,0 +1,117 @@
+#include "win_byte_fix.h"
+#include "ProjectFile.h"
+#include <fstream>
+#include <filesystem>
+#include <iterator>
+#include <cstring>
+
+const char* ProjectFile::BINARY_EXTENSION = ".vstage";
+
+static const char MAGIC[8] = { 'V', 'S', 'T', 'G', 'B', 'I', 'N', '\0' };
+static const size_t HEADER_SIZE = 16;
+
+static void putU32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; i++) out.push_back((char)((v >> (i * 8)) & 0xff));
+}
+
+static uint32_t getU32(const std::string& in, size_t offset) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= (uint32_t)(uint8_t)in[offset + i] << (i * 8);
+    return v;
+}
+
+ProjectFile::Format ProjectFile::formatForPath(const std::string& path) {
+    size_t n = strlen(BINARY_EXTENSION);
+    if (path.size() >= n && ofToLower(path.substr(path.size() - n)) == BINARY_EXTENSION) {
+        return Format::Binary;
+    }
+    return Format::Json;
+}
+
+// --- Encode / decode ---
+
+std::string ProjectFile::encode(const ofJson& root, Format format) {
+    if (format == Format::Json) {
+        return root.dump(4); // same layout as ofSavePrettyJson
+    }
+
+    std::vector<uint8_t> cbor = ofJson::to_cbor(root);
+    std::string out(MAGIC, sizeof(MAGIC));
+    putU32(out, BINARY_VERSION);
+    putU32(out, 0);
+    out.append(reinterpret_cast<const char*>(cbor.data()), cbor.size());
+    return out;
+}
+
+bool ProjectFile::decode(const std::string& bytes, ofJson& outRoot, std::string& outError) {
+    try {
+        if (bytes.size() >= HEADER_SIZE && memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) == 0) {
+            uint32_t version = getU32(bytes, 8);
+            if (version > BINARY_VERSION) {
+                outError = "Binary project version " + ofToString(version) + " is newer than this build supports";
+                return false;
+            }
+            outRoot = ofJson::from_cbor(bytes.begin() + HEADER_SIZE, bytes.end());
+        } else {
+            outRoot = ofJson::parse(bytes);
+        }
+    } catch (std::exception& e) {
+        outError = e.what();
+        return false;
+    }
+    return true;
+}
+
+// --- File I/O ---
+
+bool ProjectFile::save(const std::string& path, const ofJson& root, Format format) {
+    std::string bytes = encode(root, format);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        ofLogError("ProjectFile") << "Cannot open for writing: " << path;
+        return false;
+    }
+    out.write(bytes.data(), (std::streamsize)bytes.size());
+    return (bool)out;
+}
+
+bool ProjectFile::load(const std::string& path, ofJson& outRoot) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        ofLogError("ProjectFile") << "Cannot open: " << path;
+        return false;
+    }
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::string err;
+    if (!decode(bytes, outRoot, err)) {
+        ofLogError("ProjectFile") << "Failed to read " << path << ": " << err;
+        return false;
+    }
+    return true;
+}
+
+bool ProjectFile::writeAtomically(const std::string& path, const std::string& bytes) {
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            ofLogError("ProjectFile") << "Cannot open " << tmpPath;
+            return false;
+        }
+        out.write(bytes.data(), (std::streamsize)bytes.size());
+        if (!out) {
+            ofLogError("ProjectFile") << "Write failed: " << tmpPath;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        ofLogError("ProjectFile") << "Rename failed for " << path << ": " << ec.message();
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
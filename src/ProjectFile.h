@@ -0,0 +1,34 @@
+#pragma once
+#include "ofMain.h"
+#include <string>
+
+// On-disk project encodings. Both carry the same JSON document
+// (Scene::toJson); the binary form is a small header followed by CBOR.
+//
+//   Binary layout:  "VSTGBIN\0"  (8 bytes magic)
+//                   uint32 LE    format version
+//                   uint32 LE    reserved (0)
+//                   CBOR payload
+//
+// Loading sniffs the magic, so either format opens from any path.
+class ProjectFile {
+public:
+    enum class Format { Json, Binary };
+
+    static const char* BINARY_EXTENSION; // ".vstage"
+    static const uint32_t BINARY_VERSION = 1;
+
+    // Binary for *.vstage, pretty JSON for anything else
+    static Format formatForPath(const std::string& path);
+
+    // Encode/decode in memory (used by save/load and the autosave worker)
+    static std::string encode(const ofJson& root, Format format);
+    static bool decode(const std::string& bytes, ofJson& outRoot, std::string& outError);
+
+    static bool save(const std::string& path, const ofJson& root, Format format);
+    static bool load(const std::string& path, ofJson& outRoot);
+
+    // Write "<path>.tmp", then rename it over path: readers see either the
+    // previous file or the complete new one (autosave, project cache)
+    static bool writeAtomically(const std::string& path, const std::string& bytes);
+};
@@ -1,5 +1,6 @@
 #include "win_byte_fix.h"
 #include "PropertiesPanel.h"
+#include "Scene.h"
 
 void PropertiesPanel::setup(float x, float y) {
     // Main panel: header + labels only
@@ -28,6 +29,7 @@ void PropertiesPanel::setup(float x, float y) {
 
     curvatureGui.setup("Curvature");
     curvatureGui.add(curvatureParam);
+    curvatureGui.add(curveAxisParam);
 
     cropGui.setup("Input Mapping (M to edit)");
     cropGui.add(cropX);
@@ -45,6 +47,7 @@ void PropertiesPanel::setup(float x, float y) {
     widthParam.addListener(this, &PropertiesPanel::onParamChanged);
     heightParam.addListener(this, &PropertiesPanel::onParamChanged);
     curvatureParam.addListener(this, &PropertiesPanel::onParamChanged);
+    curveAxisParam.addListener(this, &PropertiesPanel::onAxisChanged);
     cropX.addListener(this, &PropertiesPanel::onParamChanged);
     cropY.addListener(this, &PropertiesPanel::onParamChanged);
     cropW.addListener(this, &PropertiesPanel::onParamChanged);
@@ -139,6 +142,7 @@ void PropertiesPanel::setMultipleTargets(const std::vector<ScreenObject*>& targe
         heightParam = preferences->oglToDisplay(avgH);
     }
     curvatureParam = avgCurv;
+    curveAxisParam = multiTargets.empty() ? 0 : (int)multiTargets[0]->getCurveAxis();
     syncing = false;
 
     captureLastValues();
@@ -167,6 +171,7 @@ void PropertiesPanel::syncFromTarget() {
     }
 
     curvatureParam = target->getCurvature();
+    curveAxisParam = (int)target->getCurveAxis();
 
     const ofRectangle& crop = target->getCropRect();
     cropX = crop.x;
@@ -206,6 +211,22 @@ void PropertiesPanel::onParamChanged(float& val) {
     }
 }
 
+// Axis is a choice, not a delta: every target gets the selected axis
+void PropertiesPanel::onAxisChanged(int& val) {
+    if (syncing) return;
+    if (onPropertyChanged) onPropertyChanged();
+    CurveAxis axis = (CurveAxis)ofClamp(val, 0, 2);
+    if (multiMode) {
+        if (scene) scene->beginBatch();
+        for (auto* t : multiTargets) {
+            if (t) t->setCurveAxis(axis);
+        }
+        if (scene) scene->commit();
+    } else if (target) {
+        target->setCurveAxis(axis);
+    }
+}
+
 void PropertiesPanel::captureLastValues() {
     lastPos = glm::vec3(posX, posY, posZ);
     lastRot = glm::vec3(rotX, rotY, rotZ);
@@ -221,6 +242,7 @@ void PropertiesPanel::syncToMultiTargets() {
     glm::vec2 deltaSize = glm::vec2(widthParam, heightParam) - lastSize;
     float deltaCurv = curvatureParam - lastCurvature;
 
+    if (scene) scene->beginBatch();
     for (auto* t : multiTargets) {
         if (!t) continue;
         t->setPosition(t->getPosition() + deltaPos);
@@ -240,6 +262,7 @@ void PropertiesPanel::syncToMultiTargets() {
         }
         t->setCurvature(t->getCurvature() + deltaCurv);
     }
+    if (scene) scene->commit();
 
     captureLastValues();
 }
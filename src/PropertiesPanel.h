@@ -5,6 +5,8 @@
 #include "Preferences.h"
 #include <functional>
 
+class Scene;
+
 class PropertiesPanel {
 public:
     void setup(float x, float y);
@@ -27,6 +29,8 @@ public:
 
     // Preferences (unit conversion for width/height display)
     void setPreferences(Preferences* p) { preferences = p; }
+    // Scene, so multi-target edits apply as one batch
+    void setScene(Scene* s) { scene = s; }
     void refreshUnitLabels();
 
     // Ambient light (0-100, default 60)
@@ -52,6 +56,7 @@ private:
     ofParameter<float> heightParam{"Height (m)", 1.8, 0.01, 100};
 
     ofParameter<float> curvatureParam{"Curvature", 0, -180, 180};
+    ofParameter<int> curveAxisParam{"Axis (H/V/Sphere)", 0, 0, 2};
 
     ofParameter<float> cropX{"Crop X", 0, 0, 1};
     ofParameter<float> cropY{"Crop Y", 0, 0, 1};
@@ -70,6 +75,7 @@ private:
     ofxLabel sourceLabel;
 
     Preferences* preferences = nullptr;
+    Scene* scene = nullptr;
     ScreenObject* target = nullptr;
     std::vector<ScreenObject*> multiTargets;
     bool visible = true;
@@ -91,6 +97,7 @@ private:
     bool visCrop = true;
 
     void onParamChanged(float& val);
+    void onAxisChanged(int& val);
     void onAmbientReset(bool& val);
     void captureLastValues();
     void syncToMultiTargets();
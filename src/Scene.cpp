@@ -1,5 +1,9 @@
 #include "win_byte_fix.h"
 #include "Scene.h"
+#include "ProjectFile.h"
+#include <thread>
+#include <atomic>
+#include <unordered_map>
 
 void Scene::setup() {
     light.setDirectional();
@@ -7,6 +11,8 @@ void Scene::setup() {
     light.setDiffuseColor(ofFloatColor(0.9f, 0.9f, 0.9f));
     light.setAmbientColor(ofFloatColor(0.4f, 0.4f, 0.4f));
 
+    renderer.setup();
+
 #ifdef TARGET_OSX
     ofAddListener(directory.events.serverAnnounced, this, &Scene::onServerAnnounced);
     ofAddListener(directory.events.serverRetired, this, &Scene::onServerRetired);
@@ -15,11 +21,10 @@ void Scene::setup() {
 }
 
 void Scene::update() {
+    // Receive each sender once, however many screens show it
+    sources.update();
+
 #ifdef TARGET_WIN32
-    // Receive Spout textures each frame
-    for (auto& screen : screens) {
-        screen->updateSpout();
-    }
     // Poll for new/removed senders periodically
     spoutPollTimer += ofGetLastFrameTime();
     if (spoutPollTimer >= 1.0f) {
@@ -30,22 +35,33 @@ void Scene::update() {
 }
 
 void Scene::draw(bool viewMode) {
-    ofEnableLighting();
-    light.enable();
-
-    for (auto& screen : screens) {
-        screen->draw(viewMode);
-    }
-
-    // Draw selection highlight for all selected screens
-    for (int idx : selectedIndices) {
-        if (idx >= 0 && idx < (int)screens.size()) {
-            screens[idx]->drawSelected();
+    // Cull against the active camera (called between cam.begin()/end())
+    glm::mat4 projection = ofGetCurrentMatrix(OF_MATRIX_PROJECTION);
+    glm::mat4 modelView = ofGetCurrentMatrix(OF_MATRIX_MODELVIEW);
+    updateVisibility(projection * modelView);
+    renderer.setCamera(projection, modelView);
+
+    // Screens draw through their own shaders, which ignore oF's lighting;
+    // hand them the light instead (a directional light shines along -Z)
+    glm::vec3 toLight = glm::normalize(glm::mat3(modelView) * -light.getLookAtDir());
+    renderer.setLight(toLight, light.getAmbientColor().r, light.getDiffuseColor().r);
+
+    // Only visible screens lock their source, so off-screen Spout senders
+    // are not received next frame either (see SourceRegistry::update)
+    renderer.draw(store, visibleIndices, viewMode);
+
+    // Draw selection highlight for visible selected screens
+    for (int idx : visibleIndices) {
+        if (isSelected(idx)) {
+            screens[idx]->drawSelected(renderer.getScreenShader(), renderer.pixelsPerUnit(store.getCenter(idx)));
         }
     }
+}
 
-    light.disable();
-    ofDisableLighting();
+void Scene::updateVisibility(const glm::mat4& viewProjection) {
+    syncStore();
+    visibleIndices.clear();
+    store.cull(Frustum::fromMatrix(viewProjection), visibleIndices); // list order
 }
 
 void Scene::drawGrid(float size, float step) {
@@ -84,32 +100,127 @@ int Scene::addScreen(const std::string& name) {
     screen->setPosition(glm::vec3(offset, 150, 0));
 
     screens.push_back(std::move(screen));
+    slotOfIndex.push_back(allocSlot((int)screens.size() - 1));
+    attach(*screens.back());
+    return (int)screens.size() - 1;
+}
+
+int Scene::adoptScreen(std::unique_ptr<ScreenObject> screen) {
+    ScreenObject& s = *screen;
+    beginBatch();
+    screens.push_back(std::move(screen));
+    slotOfIndex.push_back(allocSlot((int)screens.size() - 1));
+    attach(s);
+    reconnectSource(s);
+    commit();
     return (int)screens.size() - 1;
 }
 
 void Scene::removeScreen(int index) {
-    if (index >= 0 && index < (int)screens.size()) {
-        screens.erase(screens.begin() + index);
-
-        // Rebuild selectedIndices: remove the deleted index, shift down indices above it
-        std::set<int> newSelection;
-        for (int idx : selectedIndices) {
-            if (idx < index) {
-                newSelection.insert(idx);
-            } else if (idx > index) {
-                newSelection.insert(idx - 1);
-            }
-            // idx == index is removed
-        }
-        selectedIndices = newSelection;
+    removeScreens({ index });
+}
 
-        // Update primarySelected
-        if (primarySelected == index) {
-            primarySelected = selectedIndices.empty() ? -1 : *selectedIndices.begin();
-        } else if (primarySelected > index) {
-            primarySelected--;
+void Scene::removeScreens(const std::vector<int>& indices) {
+    std::vector<char> doomed(screens.size(), 0);
+    int first = (int)screens.size();
+    journal.hold();
+    for (int i : indices) {
+        if (i < 0 || i >= (int)screens.size() || doomed[i]) continue;
+        doomed[i] = 1;
+        journal.record(SceneEvent::ScreenRemoved, screens[i]->uid);
+        freeSlot(slotOfIndex[i]);
+        first = std::min(first, i);
+    }
+    if (first == (int)screens.size()) {
+        journal.release();
+        return;
+    }
+
+    // Compact once, however many screens go
+    int out = first;
+    for (int i = first; i < (int)screens.size(); i++) {
+        if (doomed[i]) continue;
+        screens[out] = std::move(screens[i]);
+        slotOfIndex[out] = slotOfIndex[i];
+        out++;
+    }
+    screens.resize(out);
+    slotOfIndex.resize(out);
+    reindexFrom(first);
+
+    // Primary went with its screen: fall back to the first remaining selection
+    if (indexOf(primary) < 0) {
+        int next = firstSelectedIndex();
+        primary = next >= 0 ? getHandle(next) : ScreenHandle();
+    }
+    journal.release();
+}
+
+void Scene::clearScreens() {
+    journal.hold();
+    for (size_t i = 0; i < screens.size(); i++) {
+        journal.record(SceneEvent::ScreenRemoved, screens[i]->uid);
+        freeSlot(slotOfIndex[i]);
+    }
+    screens.clear();
+    slotOfIndex.clear();
+    primary = ScreenHandle();
+    journal.release();
+}
+
+void Scene::setScreenOrder(const std::vector<uint64_t>& uidOrder,
+                           std::unordered_map<uint64_t, std::unique_ptr<ScreenObject>> created) {
+    // Current screens by uid, keeping their slots
+    struct Owned {
+        std::unique_ptr<ScreenObject> screen;
+        uint32_t slot = 0;
+        bool hasSlot = false;
+    };
+    std::unordered_map<uint64_t, Owned> pool;
+    for (size_t i = 0; i < screens.size(); i++) {
+        uint64_t uid = screens[i]->uid;
+        pool[uid] = { std::move(screens[i]), slotOfIndex[i], true };
+    }
+    // A created uid that is still in the scene keeps the existing screen and
+    // its slot; replacing it would orphan that slot
+    for (auto& kv : created) {
+        if (pool.count(kv.first)) continue;
+        pool[kv.first] = { std::move(kv.second), 0, false };
+    }
+
+    journal.hold();
+    screens.clear();
+    slotOfIndex.clear();
+    for (uint64_t uid : uidOrder) {
+        auto it = pool.find(uid);
+        if (it == pool.end() || !it->second.screen) continue;
+        screens.push_back(std::move(it->second.screen));
+        if (it->second.hasSlot) {
+            slotOfIndex.push_back(it->second.slot);
+        } else {
+            slotOfIndex.push_back(allocSlot((int)screens.size() - 1));
+            attach(*screens.back());
         }
+        it->second.hasSlot = false; // consumed
+    }
+    // Whatever was not placed is destroyed with the pool
+    for (auto& kv : pool) {
+        if (!kv.second.hasSlot) continue;
+        journal.record(SceneEvent::ScreenRemoved, kv.first);
+        freeSlot(kv.second.slot);
     }
+
+    reindexFrom(0);
+    if (indexOf(primary) < 0) {
+        int next = firstSelectedIndex();
+        primary = next >= 0 ? getHandle(next) : ScreenHandle();
+    }
+    journal.release();
+}
+
+void Scene::attach(ScreenObject& screen) {
+    screen.setJournal(&journal);
+    journal.record(SceneEvent::ScreenAdded, screen.uid);
 }
 
 int Scene::getScreenCount() const {
@@ -123,6 +234,52 @@ ScreenObject* Scene::getScreen(int index) {
     return nullptr;
 }
 
+// --- Slot map ---
+
+ScreenHandle Scene::getHandle(int index) const {
+    if (index < 0 || index >= (int)slotOfIndex.size()) return ScreenHandle();
+    uint32_t slot = slotOfIndex[index];
+    return { slot, slots[slot].generation };
+}
+
+int Scene::indexOf(ScreenHandle handle) const {
+    if (handle.isNull() || handle.slot >= slots.size()) return -1;
+    const Slot& s = slots[handle.slot];
+    return (s.generation == handle.generation) ? s.index : -1;
+}
+
+ScreenObject* Scene::getScreen(ScreenHandle handle) {
+    return getScreen(indexOf(handle));
+}
+
+uint32_t Scene::allocSlot(int index) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = (uint32_t)slots.size();
+        slots.emplace_back();
+        if (selectionBits.size() * 64 < slots.size()) selectionBits.push_back(0);
+    }
+    slots[slot].index = index;
+    return slot;
+}
+
+void Scene::freeSlot(uint32_t slot) {
+    setSelected(slot, false);
+    slots[slot].index = -1;
+    slots[slot].generation++; // outstanding handles go stale
+    if (slots[slot].generation == 0) slots[slot].generation = 1;
+    freeSlots.push_back(slot);
+}
+
+void Scene::reindexFrom(int first) {
+    for (int i = first; i < (int)slotOfIndex.size(); i++) {
+        slots[slotOfIndex[i]].index = i;
+    }
+}
+
 std::vector<ServerInfo> Scene::getAvailableServers() const {
     std::vector<ServerInfo> servers;
 #ifdef TARGET_OSX
@@ -157,16 +314,17 @@ void Scene::assignSourceToScreen(int screenIndex, int serverIndex) {
         screen->disconnectSource();
         return;
     }
-    const auto& desc = directory.getDescription(serverIndex);
-    screen->sourceIndex = serverIndex;
-    screen->connectToSource(desc);
+    screen->connectToSource(sources.acquire(directory.getDescription(serverIndex)));
+    if (screen->hasSource()) screen->sourceIndex = serverIndex;
+    ofLogNotice("Scene") << screen->name << " connected to: " << screen->sourceName;
 #elif defined(TARGET_WIN32)
     if (serverIndex < 0 || serverIndex >= (int)spoutSenders.size()) {
         screen->disconnectSource();
         return;
     }
-    screen->sourceIndex = serverIndex;
-    screen->connectToSource(spoutSenders[serverIndex]);
+    screen->connectToSource(sources.acquire(spoutSenders[serverIndex]));
+    if (screen->hasSource()) screen->sourceIndex = serverIndex;
+    ofLogNotice("Scene") << screen->name << " connected to: " << screen->sourceName;
 #endif
 }
 
@@ -226,7 +384,27 @@ void Scene::pollSpoutSenders() {
 
 // --- Project Save/Load ---
 
-bool Scene::saveProject(const std::string& path, const ofJson& cameraJson) const {
+// Run fn(0..count-1) across hardware threads; small jobs stay on the caller
+static void parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+    const size_t minPerThread = 16;
+    size_t threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                      count / minPerThread);
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; i++) fn(i);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) fn(i);
+    };
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
+
+ofJson Scene::toJson(const ofJson& cameraJson) const {
     ofJson root;
     root["version"] = 1;
 
@@ -239,19 +417,20 @@ bool Scene::saveProject(const std::string& path, const ofJson& cameraJson) const
         screensArr.push_back(screen->toJson());
     }
     root["screens"] = screensArr;
-
-    return ofSavePrettyJson(path, root);
+    return root;
 }
 
-bool Scene::loadProject(const std::string& path, ofJson* outCameraJson) {
-    ofJson root = ofLoadJson(path);
-    if (root.is_null() || !root.contains("screens")) {
-        ofLogError("Scene") << "Failed to load project or missing 'screens': " << path;
+bool Scene::fromJson(const ofJson& root, ofJson* outCameraJson) {
+    if (root.is_null() || !root.contains("screens") || !root["screens"].is_array()) {
+        ofLogError("Scene") << "Project data missing 'screens'";
         return false;
     }
 
+    // One batch: a single change notification, one acquire per source
+    beginBatch();
+
     // Clear existing screens
-    screens.clear();
+    clearScreens();
     clearSelection();
     nextScreenId = 1;
 
@@ -260,158 +439,274 @@ bool Scene::loadProject(const std::string& path, ofJson* outCameraJson) {
         *outCameraJson = root["camera"];
     }
 
-    // Load screens
-    for (auto& sj : root["screens"]) {
-        auto screen = std::make_unique<ScreenObject>();
-        screen->fromJson(sj);
+    // Load screens: parsing and mask rasterizing (CPU only — mask textures
+    // upload on first draw; grids come from MeshPool) run across cores;
+    // sources connect on this thread
+    const ofJson& arr = root["screens"];
+    std::vector<std::unique_ptr<ScreenObject>> loaded(arr.size());
+    parallelFor(arr.size(), [&](size_t i) {
+        try {
+            auto screen = std::make_unique<ScreenObject>();
+            screen->fromJson(arr[i]);
+            screen->ensureGeometry(); // rasterize masks here, not on the first frame
+            loaded[i] = std::move(screen);
+        } catch (std::exception& e) {
+            ofLogError("Scene") << "Skipping malformed screen " << i << ": " << e.what();
+        }
+    });
+    for (auto& screen : loaded) {
+        if (!screen) continue;
         screens.push_back(std::move(screen));
+        slotOfIndex.push_back(allocSlot((int)screens.size() - 1));
+        attach(*screens.back());
         nextScreenId++;
     }
 
     reconnectSources();
+    commit();
+    return true;
+}
+
+bool Scene::saveProject(const std::string& path, const ofJson& cameraJson) const {
+    std::string fullPath = ofToDataPath(path);
+    return ProjectFile::save(fullPath, toJson(cameraJson), ProjectFile::formatForPath(fullPath));
+}
+
+bool Scene::loadProject(const std::string& path, ofJson* outCameraJson) {
+    ofJson root;
+    if (!ProjectFile::load(ofToDataPath(path), root) || !fromJson(root, outCameraJson)) {
+        ofLogError("Scene") << "Failed to load project: " << path;
+        return false;
+    }
 
     ofLogNotice("Scene") << "Loaded project: " << screens.size() << " screens from " << path;
     return true;
 }
 
 void Scene::reconnectSources() {
-#ifdef TARGET_OSX
-    const auto& serverList = directory.getServerList();
+#ifdef TARGET_WIN32
+    pollSpoutSenders(); // refresh sender list
+#endif
+    beginBatch();
     for (auto& screen : screens) {
-        if (screen->sourceName.empty()) continue;
-        for (int i = 0; i < (int)serverList.size(); i++) {
-            std::string displayName = serverList[i].appName + " - " + serverList[i].serverName;
-            if (displayName == screen->sourceName) {
-                screen->connectToSource(serverList[i]);
-                screen->sourceIndex = i;
-                ofLogNotice("Scene") << "Reconnected '" << screen->name << "' to: " << displayName;
-                break;
-            }
+        reconnectSource(*screen);
+    }
+    commit();
+}
+
+void Scene::reconnectSource(ScreenObject& screen) {
+    if (screen.sourceName.empty()) return;
+    if (batchDepth > 0) {
+        pendingReconnects.insert(screen.uid);
+        return;
+    }
+    connectBySourceName({ &screen });
+}
+
+void Scene::connectBySourceName(const std::vector<ScreenObject*>& targets) {
+    // Group by name: one directory lookup and one acquire per source
+    std::unordered_map<std::string, std::vector<ScreenObject*>> byName;
+    for (auto* screen : targets) {
+        if (!screen->sourceName.empty()) byName[screen->sourceName].push_back(screen);
+    }
+
+    auto connectGroup = [](const std::string& displayName, const std::vector<ScreenObject*>& group,
+                           std::shared_ptr<SharedSource> shared, int index) {
+        for (auto* screen : group) {
+            screen->connectToSource(shared);
+            if (screen->hasSource()) screen->sourceIndex = index;
         }
+        if (group.size() == 1) {
+            ofLogNotice("Scene") << "Reconnected '" << group[0]->name << "' to: " << displayName;
+        } else {
+            ofLogNotice("Scene") << "Reconnected " << group.size() << " screens to: " << displayName;
+        }
+    };
+
+#ifdef TARGET_OSX
+    const auto& serverList = directory.getServerList();
+    for (int i = 0; i < (int)serverList.size() && !byName.empty(); i++) {
+        std::string displayName = serverList[i].appName + " - " + serverList[i].serverName;
+        auto it = byName.find(displayName);
+        if (it == byName.end()) continue;
+        connectGroup(displayName, it->second, sources.acquire(serverList[i]), i);
+        byName.erase(it);
     }
 #elif defined(TARGET_WIN32)
-    pollSpoutSenders(); // refresh sender list
-    for (auto& screen : screens) {
-        if (screen->sourceName.empty()) continue;
-        for (int i = 0; i < (int)spoutSenders.size(); i++) {
-            if (spoutSenders[i] == screen->sourceName) {
-                screen->connectToSource(spoutSenders[i]);
-                screen->sourceIndex = i;
-                ofLogNotice("Scene") << "Reconnected '" << screen->name << "' to: " << spoutSenders[i];
-                break;
-            }
-        }
+    for (int i = 0; i < (int)spoutSenders.size() && !byName.empty(); i++) {
+        auto it = byName.find(spoutSenders[i]);
+        if (it == byName.end()) continue;
+        connectGroup(spoutSenders[i], it->second, sources.acquire(spoutSenders[i]), i);
+        byName.erase(it);
     }
 #endif
 }
 
-int Scene::pick(const ofCamera& cam, const glm::vec2& screenPos) {
-    // Build ray from camera through screen point
-    glm::vec3 nearPoint = cam.screenToWorld(glm::vec3(screenPos.x, screenPos.y, 0.0f));
-    glm::vec3 farPoint = cam.screenToWorld(glm::vec3(screenPos.x, screenPos.y, 1.0f));
-    glm::vec3 rayDir = glm::normalize(farPoint - nearPoint);
-    glm::vec3 rayOrigin = nearPoint;
+// --- Batches ---
 
-    int closestIndex = -1;
-    float closestT = std::numeric_limits<float>::max();
+void Scene::beginBatch() {
+    batchDepth++;
+    journal.hold();
+}
 
-    for (int i = 0; i < (int)screens.size(); i++) {
-        float t;
-        if (rayIntersectsScreen(rayOrigin, rayDir, *screens[i], t)) {
-            if (t < closestT) {
-                closestT = t;
-                closestIndex = i;
-            }
+void Scene::commit() {
+    if (batchDepth == 0) return;
+    if (batchDepth == 1 && !pendingReconnects.empty()) {
+        std::vector<ScreenObject*> targets;
+        for (auto& screen : screens) {
+            if (pendingReconnects.count(screen->uid)) targets.push_back(screen.get());
         }
+        pendingReconnects.clear();
+        connectBySourceName(targets);
     }
+    batchDepth--;
+    journal.release(); // the batch's events, coalesced, in one delivery
+}
 
-    return closestIndex;
+void Scene::syncStore() {
+    // Every edit to a screen in the list is journaled, so an unchanged
+    // content sequence means no slot can be stale
+    if (journal.getContentSequence() == storeSequence) return;
+    store.sync(screens);
+    storeSequence = journal.getContentSequence();
 }
 
-bool Scene::rayIntersectsScreen(const glm::vec3& rayOrigin, const glm::vec3& rayDir,
-                                const ScreenObject& screen, float& t) {
-    glm::vec3 normal = screen.getWorldNormal();
-    glm::vec3 center = screen.getWorldCenter();
+int Scene::pick(const ofCamera& cam, const glm::vec2& screenPos) {
+    // Build ray from camera through screen point
+    glm::vec3 nearPoint = cam.screenToWorld(glm::vec3(screenPos.x, screenPos.y, 0.0f));
+    glm::vec3 farPoint = cam.screenToWorld(glm::vec3(screenPos.x, screenPos.y, 1.0f));
+    glm::vec3 rayDir = glm::normalize(farPoint - nearPoint);
+    glm::vec3 rayOrigin = nearPoint;
 
-    float denom = glm::dot(normal, rayDir);
-    if (std::abs(denom) < 1e-6f) return false;
+    syncStore();
+    bvh.update(store);
+    float t;
+    return bvh.raycast(store, rayOrigin, rayDir, t);
+}
 
-    t = glm::dot(center - rayOrigin, normal) / denom;
-    if (t < 0) return false;
+// --- Multi-selection helpers ---
 
-    glm::vec3 hitPoint = rayOrigin + rayDir * t;
+static uint32_t lowestBit(uint64_t v) {
+    uint32_t n = 0;
+    while (!(v & 1)) { v >>= 1; n++; }
+    return n;
+}
 
-    // Transform to local space
-    glm::mat4 invTransform = glm::inverse(screen.plane.getGlobalTransformMatrix());
-    glm::vec3 localHit = glm::vec3(invTransform * glm::vec4(hitPoint, 1.0f));
+bool Scene::testSelected(uint32_t slot) const {
+    return (selectionBits[slot >> 6] >> (slot & 63)) & 1;
+}
 
-    return (std::abs(localHit.x) <= screen.getPlaneWidth() * 0.5f &&
-            std::abs(localHit.y) <= screen.getPlaneHeight() * 0.5f);
+void Scene::setSelected(uint32_t slot, bool on) {
+    if (testSelected(slot) == on) return;
+    selectionBits[slot >> 6] ^= (uint64_t)1 << (slot & 63);
+    selectionCount += on ? 1 : -1;
+    journal.record(SceneEvent::SelectionChanged);
 }
 
-// --- Multi-selection helpers ---
+int Scene::firstSelectedIndex() const {
+    int best = -1;
+    if (selectionCount == 0) return best;
+    for (size_t w = 0; w < selectionBits.size(); w++) {
+        for (uint64_t bits = selectionBits[w]; bits; bits &= bits - 1) {
+            int index = slots[w * 64 + lowestBit(bits)].index;
+            if (best < 0 || index < best) best = index;
+        }
+    }
+    return best;
+}
 
 void Scene::selectOnly(int index) {
-    selectedIndices.clear();
+    journal.hold();
+    clearSelection();
     if (index >= 0 && index < (int)screens.size()) {
-        selectedIndices.insert(index);
-        primarySelected = index;
-    } else {
-        primarySelected = -1;
+        setSelected(slotOfIndex[index], true);
+        primary = getHandle(index);
     }
+    journal.release();
 }
 
 void Scene::toggleSelected(int index) {
     if (index < 0 || index >= (int)screens.size()) return;
-    if (selectedIndices.count(index)) {
-        selectedIndices.erase(index);
-        if (primarySelected == index) {
-            primarySelected = selectedIndices.empty() ? -1 : *selectedIndices.begin();
+    uint32_t slot = slotOfIndex[index];
+    if (testSelected(slot)) {
+        setSelected(slot, false);
+        if (indexOf(primary) == index) {
+            int next = firstSelectedIndex();
+            primary = next >= 0 ? getHandle(next) : ScreenHandle();
         }
     } else {
-        selectedIndices.insert(index);
-        primarySelected = index;
+        setSelected(slot, true);
+        primary = getHandle(index);
     }
 }
 
 void Scene::clearSelection() {
-    selectedIndices.clear();
-    primarySelected = -1;
+    if (selectionCount > 0) journal.record(SceneEvent::SelectionChanged);
+    std::fill(selectionBits.begin(), selectionBits.end(), 0);
+    selectionCount = 0;
+    primary = ScreenHandle();
 }
 
 void Scene::selectRange(int from, int to) {
-    int lo = std::min(from, to);
-    int hi = std::max(from, to);
-    selectedIndices.clear();
-    for (int i = lo; i <= hi && i < (int)screens.size(); i++) {
-        if (i >= 0) selectedIndices.insert(i);
-    }
-    primarySelected = to;
+    journal.hold();
+    clearSelection();
+    int lo = std::max(0, std::min(from, to));
+    int hi = std::min(std::max(from, to), (int)screens.size() - 1);
+    for (int i = lo; i <= hi; i++) setSelected(slotOfIndex[i], true);
+    primary = getHandle(to);
+    journal.release();
 }
 
 void Scene::selectInRect(const ofCamera& cam, const ofRectangle& screenRect) {
+    journal.hold();
     clearSelection();
-    for (int i = 0; i < (int)screens.size(); i++) {
-        glm::vec3 sp = cam.worldToScreen(screens[i]->getPosition());
-        if (screenRect.inside(sp.x, sp.y)) {
-            selectedIndices.insert(i);
-            if (primarySelected < 0) primarySelected = i;
-        }
-    }
+
+    // A screen is selected when its center projects inside the rectangle;
+    // one pass over the store's center arrays in clip space
+    ofRectangle vp = ofGetCurrentViewport();
+    float x0 = 2.0f * (screenRect.getLeft() - vp.x) / vp.width - 1.0f;
+    float x1 = 2.0f * (screenRect.getRight() - vp.x) / vp.width - 1.0f;
+    float y0 = 1.0f - 2.0f * (screenRect.getBottom() - vp.y) / vp.height;
+    float y1 = 1.0f - 2.0f * (screenRect.getTop() - vp.y) / vp.height;
+
+    syncStore();
+    std::vector<int> hits;
+    store.centersInside(cam.getModelViewProjectionMatrix(vp), x0, x1, y0, y1, hits);
+    for (int i : hits) setSelected(slotOfIndex[i], true);
+    if (!hits.empty()) primary = getHandle(hits.front());
+    journal.release();
 }
 
 bool Scene::isSelected(int index) const {
-    return selectedIndices.count(index) > 0;
+    return index >= 0 && index < (int)slotOfIndex.size() && testSelected(slotOfIndex[index]);
 }
 
 int Scene::getPrimarySelected() const {
-    return primarySelected;
+    return indexOf(primary);
 }
 
 int Scene::getSelectionCount() const {
-    return (int)selectedIndices.size();
+    return selectionCount;
 }
 
 std::vector<int> Scene::getSelectedIndicesSorted() const {
-    return std::vector<int>(selectedIndices.begin(), selectedIndices.end());
+    std::vector<int> out;
+    out.reserve(selectionCount);
+    for (size_t w = 0; w < selectionBits.size() && (int)out.size() < selectionCount; w++) {
+        for (uint64_t bits = selectionBits[w]; bits; bits &= bits - 1) {
+            out.push_back(slots[w * 64 + lowestBit(bits)].index);
+        }
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+void Scene::setSelection(const std::vector<int>& indices, int primaryIndex) {
+    journal.hold();
+    clearSelection();
+    for (int i : indices) {
+        if (i >= 0 && i < (int)screens.size()) setSelected(slotOfIndex[i], true);
+    }
+    primary = getHandle(primaryIndex);
+    journal.release();
 }
@@ -1,9 +1,14 @@
 #pragma once
 #include "ofMain.h"
 #include "ScreenObject.h"
+#include "SceneRenderer.h"
+#include "ScreenStore.h"
+#include "ScreenBVH.h"
+#include "SceneJournal.h"
 #include <vector>
-#include <set>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <functional>
 
 #ifdef TARGET_OSX
@@ -13,6 +18,17 @@
 #include "SpoutReceiver.h"
 #endif
 
+// Stable reference to a screen: survives reordering and other screens being
+// removed, and goes stale (indexOf() == -1) once its screen is removed
+struct ScreenHandle {
+    uint32_t slot = 0;
+    uint32_t generation = 0; // 0 = null handle
+
+    bool isNull() const { return generation == 0; }
+    bool operator==(const ScreenHandle& o) const { return slot == o.slot && generation == o.generation; }
+    bool operator!=(const ScreenHandle& o) const { return !(*this == o); }
+};
+
 struct ServerInfo {
     std::string serverName;
     std::string appName;
@@ -33,10 +49,31 @@ public:
 
     // Object management
     int addScreen(const std::string& name = "");
+    int adoptScreen(std::unique_ptr<ScreenObject> screen); // append + reconnect by sourceName
     void removeScreen(int index);
+    void removeScreens(const std::vector<int>& indices); // one compaction pass
+    void clearScreens();
+    // Rebuild the list in uid order from the current screens plus 'created'
+    // (undo/redo). Screens already in the scene keep their handles; screens
+    // left out of the order are destroyed.
+    void setScreenOrder(const std::vector<uint64_t>& uidOrder,
+                        std::unordered_map<uint64_t, std::unique_ptr<ScreenObject>> created);
     int getScreenCount() const;
     ScreenObject* getScreen(int index);
 
+    // Handles (slot map): O(1) lookup in both directions
+    ScreenHandle getHandle(int index) const;
+    int indexOf(ScreenHandle handle) const;      // -1 if stale
+    ScreenObject* getScreen(ScreenHandle handle);
+
+    // Draw-call / batching counters from the last draw()
+    const SceneRenderer::Stats& getRenderStats() const { return renderer.getStats(); }
+
+    // Frustum culling results from the last draw()
+    const std::vector<int>& getVisibleIndices() const { return visibleIndices; }
+    int getDrawnCount() const { return (int)visibleIndices.size(); }
+    int getCulledCount() const { return store.size() - (int)visibleIndices.size(); }
+
     // Picking: returns index of hit object or -1
     int pick(const ofCamera& cam, const glm::vec2& screenPos);
 
@@ -51,20 +88,42 @@ public:
     // Assign source to a screen by server index
     void assignSourceToScreen(int screenIndex, int serverIndex);
 
-    // Update (for Spout receiver polling)
+    // Update (shared source receive + Spout sender polling)
     void update();
 
-    // Project save/load
+    // Open source receivers (one per sender in use, not per screen)
+    int getReceiverCount() const { return sources.getReceiverCount(); }
+
+    // Whole-project serialization (in memory; used for files and cloud)
+    ofJson toJson(const ofJson& cameraJson = ofJson()) const;
+    bool fromJson(const ofJson& root, ofJson* outCameraJson = nullptr);
+
+    // Typed change events (screen added/removed/edited, selection) with
+    // monotonic sequence numbers; getContentSequence() moves on any change
+    // to saved state, so it doubles as a cheap "modified since" check
+    SceneJournal& getJournal() { return journal; }
+    const SceneJournal& getJournal() const { return journal; }
+
+    // Project save/load (*.vstage = binary, otherwise JSON; load detects either)
     bool saveProject(const std::string& path, const ofJson& cameraJson = ofJson()) const;
     bool loadProject(const std::string& path, ofJson* outCameraJson = nullptr);
 
-    // Reconnect all screens to their sources by name (used after undo/redo/load)
+    // Reconnect all screens to their sources by name (used after load)
     void reconnectSources();
-
-    // Multi-selection
-    std::set<int> selectedIndices;
-    int primarySelected = -1;
-
+    // Reconnect one screen by its sourceName (used by undo/redo, duplicate)
+    void reconnectSource(ScreenObject& screen);
+
+    // Batched edits (import, load, undo, multi-select). Between beginBatch()
+    // and commit(), reconnects are queued and resolved once per unique source
+    // name, and the journal delivers the batch's events (deduped) in one go
+    // at the outermost commit. Batches nest; screens removed before commit
+    // are skipped.
+    void beginBatch();
+    void commit();
+    bool inBatch() const { return batchDepth > 0; }
+
+    // Multi-selection (stored per slot, so it follows screens when the list
+    // changes; index-based calls translate through the slot map)
     void selectOnly(int index);
     void toggleSelected(int index);
     void clearSelection();
@@ -74,14 +133,19 @@ public:
     int getPrimarySelected() const;
     int getSelectionCount() const;
     std::vector<int> getSelectedIndicesSorted() const;
+    void setSelection(const std::vector<int>& indices, int primary);
 
     // Callback when server list changes
     std::function<void()> onServerListChanged;
 
+    // Read freely; add, remove and reorder only through Scene so handles
+    // and selection stay in sync
     std::vector<std::unique_ptr<ScreenObject>> screens;
 
 private:
     ofLight light;
+    SceneRenderer renderer;    // batches flat screens, owns the shared screen shader
+    SourceRegistry sources;    // one shared receiver per sender
     int nextScreenId = 1;
 
 #ifdef TARGET_OSX
@@ -94,6 +158,44 @@ private:
     void pollSpoutSenders();
 #endif
 
-    bool rayIntersectsScreen(const glm::vec3& rayOrigin, const glm::vec3& rayDir,
-                             const ScreenObject& screen, float& t);
+    // Slot map: handle.slot → current index; generation bumps on removal
+    struct Slot {
+        uint32_t generation = 1;
+        int index = -1; // -1 = free
+    };
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::vector<uint32_t> slotOfIndex; // parallel to screens
+    uint32_t allocSlot(int index);
+    void freeSlot(uint32_t slot);
+    void reindexFrom(int first);
+
+    // Selection: one bit per slot
+    std::vector<uint64_t> selectionBits;
+    int selectionCount = 0;
+    ScreenHandle primary;
+    bool testSelected(uint32_t slot) const;
+    void setSelected(uint32_t slot, bool on);
+    int firstSelectedIndex() const;
+
+    // Change journal; screens in the list record their own edits into it
+    SceneJournal journal;
+    void attach(ScreenObject& screen);
+
+    // Open batch: depth and queued reconnects (by uid)
+    int batchDepth = 0;
+    std::unordered_set<uint64_t> pendingReconnects;
+    void connectBySourceName(const std::vector<ScreenObject*>& targets);
+
+    // Hot per-frame data mirrored from screens (synced before each pass,
+    // skipped when the journal saw no content change since)
+    ScreenStore store;
+    uint64_t storeSequence = 0;
+    void syncStore();
+    // Picking acceleration over the store's bounds (refit lazily before each query)
+    ScreenBVH bvh;
+
+    // Per-frame visibility, rebuilt at the start of draw()
+    std::vector<int> visibleIndices;   // sorted screen indices inside the frustum
+    void updateVisibility(const glm::mat4& viewProjection);
 };
@@ -0,0 +1,65 @@
+#include "win_byte_fix.h"
+#include "SceneJournal.h"
+
+int SceneJournal::subscribe(Listener listener) {
+    int id = nextListenerId++;
+    listeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void SceneJournal::unsubscribe(int id) {
+    for (size_t i = 0; i < listeners.size(); i++) {
+        if (listeners[i].first == id) {
+            listeners.erase(listeners.begin() + i);
+            return;
+        }
+    }
+}
+
+void SceneJournal::record(SceneEvent::Type type, uint64_t uid) {
+    SceneEvent e;
+    e.seq = ++sequence;
+    e.type = type;
+    e.uid = uid;
+    if (type != SceneEvent::SelectionChanged) contentSequence = e.seq;
+
+    history.push_back(e);
+    if (history.size() > HISTORY) history.pop_front();
+
+    // Sequences and history always advance; only the batch delivered to
+    // listeners drops repeats
+    if (holdDepth > 0) {
+        if (pendingKeys.insert((uid << 3) | type).second) pending.push_back(e);
+    } else {
+        deliver({ e });
+    }
+}
+
+void SceneJournal::hold() {
+    holdDepth++;
+}
+
+void SceneJournal::release() {
+    if (holdDepth == 0 || --holdDepth > 0) return;
+    std::vector<SceneEvent> events;
+    events.swap(pending);
+    pendingKeys.clear();
+    if (!events.empty()) deliver(events);
+}
+
+bool SceneJournal::eventsSince(uint64_t since, std::vector<SceneEvent>& out) const {
+    if (since >= sequence) return true;
+    // Sequences in the history are consecutive
+    if (history.empty() || history.front().seq > since + 1) return false;
+    for (size_t i = (size_t)(since + 1 - history.front().seq); i < history.size(); i++) {
+        out.push_back(history[i]);
+    }
+    return true;
+}
+
+void SceneJournal::deliver(const std::vector<SceneEvent>& events) {
+    // By index: a listener may subscribe while being called
+    for (size_t i = 0; i < listeners.size(); i++) {
+        listeners[i].second(events);
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// One change to the scene. Screen events carry the screen's uid;
+// SelectionChanged carries 0.
+struct SceneEvent {
+    enum Type : uint8_t {
+        ScreenAdded,
+        ScreenRemoved,
+        TransformChanged, // position / rotation / scale
+        ShapeChanged,     // size / curvature
+        CropChanged,
+        MaskChanged,
+        SourceChanged,
+        SelectionChanged,
+    };
+
+    uint64_t seq = 0; // monotonic, never reused
+    Type type = ScreenAdded;
+    uint64_t uid = 0;
+};
+
+// Ordered record of scene changes, owned by Scene. Screens record their own
+// edits; Scene records list and selection changes.
+//
+// Listeners are pushed each event as it happens, or one coalesced list per
+// batch while Scene holds the journal (beginBatch/commit). Consumers that
+// poll instead keep the last sequence they handled and ask eventsSince();
+// if that has dropped out of the bounded history they rescan.
+class SceneJournal {
+public:
+    using Listener = std::function<void(const std::vector<SceneEvent>&)>;
+
+    int subscribe(Listener listener); // returns an id for unsubscribe()
+    void unsubscribe(int id);
+
+    void record(SceneEvent::Type type, uint64_t uid = 0);
+
+    // While held, events are recorded but delivered together on the last
+    // release(); the delivered batch drops repeats of the same (type, uid),
+    // the sequences and history still count every one
+    void hold();
+    void release();
+
+    // Sequence of the last event, and of the last one that changed saved
+    // state (anything but selection)
+    uint64_t getSequence() const { return sequence; }
+    uint64_t getContentSequence() const { return contentSequence; }
+
+    // Events after 'since', oldest first. False if some are no longer kept.
+    bool eventsSince(uint64_t since, std::vector<SceneEvent>& out) const;
+
+    static constexpr size_t HISTORY = 4096;
+
+private:
+    uint64_t sequence = 0;
+    uint64_t contentSequence = 0;
+    std::deque<SceneEvent> history;
+
+    int holdDepth = 0;
+    std::vector<SceneEvent> pending;
+    std::unordered_set<uint64_t> pendingKeys; // uid << 3 | type
+
+    std::vector<std::pair<int, Listener>> listeners;
+    int nextListenerId = 1;
+    void deliver(const std::vector<SceneEvent>& events);
+};
@@ -0,0 +1,198 @@
+#include "win_byte_fix.h"
+#include "SceneRenderer.h"
+
+// --- Instanced shader sources ---
+
+static const char* instancedVertexSrc = R"(
+uniform mat4 modelViewProjectionMatrix; // view-projection (no model pushed)
+uniform mat4 modelViewMatrix;           // view only, likewise
+uniform float flipV;
+uniform vec2 texSize;
+
+in vec4 position;
+in vec2 texcoord;
+in mat4 instanceModel;  // global transform * scale(width, height, 1)
+in vec4 instanceCrop;   // x, y, w, h (normalized 0-1)
+
+out vec2 vTexCoord;
+out vec3 vNormal;       // eye space
+
+void main() {
+    // Plane normal from the model's in-plane axes, so scaling cannot skew it
+    vNormal = mat3(modelViewMatrix) * cross(instanceModel[0].xyz, instanceModel[1].xyz);
+    vec2 uv = instanceCrop.xy + texcoord * instanceCrop.zw;
+    if (flipV > 0.5) uv.y = 1.0 - uv.y;
+    vTexCoord = uv * texSize;
+    gl_Position = modelViewProjectionMatrix * instanceModel * position;
+}
+)";
+
+static const char* instancedFragmentSrc = R"(
+uniform SAMPLER tex0;
+uniform vec4 globalColor;
+uniform float textured;   // 0 = solid globalColor (fill without source, outline)
+uniform float overBlack;  // 1 = composite source alpha over black (View mode)
+uniform float shaded;     // 1 = light the solid fill
+uniform vec3 lightDir;    // eye space, towards the light
+uniform vec2 lightTerms;  // ambient, diffuse
+
+in vec2 vTexCoord;
+in vec3 vNormal;
+
+out vec4 outputColor;
+
+void main() {
+    if (textured < 0.5) {
+        outputColor = globalColor;
+        if (shaded > 0.5) {
+            float lambert = max(dot(normalize(vNormal), lightDir), 0.0);
+            outputColor.rgb *= min(lightTerms.x + lightTerms.y * lambert, 1.0);
+        }
+        return;
+    }
+    vec4 c = texture(tex0, vTexCoord) * globalColor;
+    // Same result as the black base pass + textured pass, in one pass
+    if (overBlack > 0.5) c = vec4(c.rgb * c.a, 1.0);
+    outputColor = c;
+}
+)";
+
+static void compileInstanced(ofShader& shader, const std::string& sampler, int modelLoc, int cropLoc) {
+    std::string header = "#version 150\n#define SAMPLER " + sampler + "\n";
+    shader.setupShaderFromSource(GL_VERTEX_SHADER, header + instancedVertexSrc);
+    shader.setupShaderFromSource(GL_FRAGMENT_SHADER, header + instancedFragmentSrc);
+    shader.bindDefaults();
+    shader.bindAttribute(modelLoc, "instanceModel"); // occupies modelLoc..modelLoc+3
+    shader.bindAttribute(cropLoc, "instanceCrop");
+    shader.linkProgram();
+}
+
+// --- SceneRenderer ---
+
+void SceneRenderer::setup() {
+    screenShader.setup();
+    compileInstanced(instanced2D, "sampler2D", INSTANCE_MODEL, INSTANCE_CROP);
+    compileInstanced(instancedRect, "sampler2DRect", INSTANCE_MODEL, INSTANCE_CROP);
+
+    // Unit quad centered on origin, same UV orientation as ofPlanePrimitive
+    glm::vec3 verts[4] = {
+        {-0.5f, -0.5f, 0}, {0.5f, -0.5f, 0}, {0.5f, 0.5f, 0}, {-0.5f, 0.5f, 0}
+    };
+    glm::vec2 uvs[4] = { {0, 1}, {1, 1}, {1, 0}, {0, 0} };
+    ofIndexType indices[6] = { 0, 1, 2, 0, 2, 3 };
+    quad.setVertexData(verts, 4, GL_STATIC_DRAW);
+    quad.setTexCoordData(uvs, 4, GL_STATIC_DRAW);
+    quad.setIndexData(indices, 6, GL_STATIC_DRAW);
+}
+
+void SceneRenderer::setLight(const glm::vec3& eyeDir, float ambient, float diffuse) {
+    lightDir = eyeDir;
+    lightAmbient = ambient;
+    lightDiffuse = diffuse;
+    screenShader.setLight(eyeDir, ambient, diffuse);
+}
+
+void SceneRenderer::setCamera(const glm::mat4& projection, const glm::mat4& modelView) {
+    viewProj = projection * modelView;
+    ppuScale = ofGetCurrentViewport().height * 0.5f * projection[1][1];
+}
+
+float SceneRenderer::pixelsPerUnit(const glm::vec3& worldPoint) const {
+    glm::vec4 clip = viewProj * glm::vec4(worldPoint, 1.0f);
+    if (clip.w <= 1e-4f) return 0; // behind or at the eye: full detail
+    return ppuScale / clip.w;
+}
+
+void SceneRenderer::draw(const ScreenStore& store, const std::vector<int>& visible, bool viewMode) {
+    stats = Stats();
+
+    // Group flat screens by shared source id; draw the rest directly
+    batches.resize(store.getSourceIdCount() + 1);
+    for (auto& b : batches) b.members.clear();
+    for (int i : visible) {
+        if (!(store.getFlags(i) & ScreenStore::FLAG_FLAT)) {
+            ScreenObject* s = store.getObject(i);
+            stats.drawCalls += s->draw(screenShader, viewMode, pixelsPerUnit(store.getCenter(i)));
+            stats.individualScreens++;
+            continue;
+        }
+        batches[store.getSourceId(i) + 1].members.push_back(i);
+    }
+
+    for (size_t b = 0; b < batches.size(); b++) {
+        auto& members = batches[b].members;
+        if (members.empty()) continue;
+
+        // Same id → same SharedSource from the registry: lock it once
+        SharedSource* src = (b == 0) ? nullptr : store.getObject(members[0])->getSource();
+        ofTexture* tex = src ? src->lock() : nullptr;
+
+        drawBatch(store, members, tex, viewMode);
+        if (tex) src->unlock();
+
+        stats.batches++;
+        stats.batchedScreens += (int)members.size();
+    }
+}
+
+void SceneRenderer::uploadInstances(const ScreenStore& store, const std::vector<int>& members) {
+    int n = (int)members.size();
+    for (auto& col : modelCols) col.resize(n);
+    crops.resize(n);
+
+    for (int k = 0; k < n; k++) {
+        const glm::mat4& m = store.getInstanceModel(members[k]);
+        for (int c = 0; c < 4; c++) modelCols[c][k] = m[c];
+        crops[k] = store.getCrop(members[k]);
+    }
+
+    for (int c = 0; c < 4; c++) {
+        quad.setAttributeData(INSTANCE_MODEL + c, &modelCols[c][0].x, 4, n, GL_STREAM_DRAW, sizeof(glm::vec4));
+        quad.setAttributeDivisor(INSTANCE_MODEL + c, 1);
+    }
+    quad.setAttributeData(INSTANCE_CROP, &crops[0].x, 4, n, GL_STREAM_DRAW, sizeof(glm::vec4));
+    quad.setAttributeDivisor(INSTANCE_CROP, 1);
+}
+
+void SceneRenderer::drawBatch(const ScreenStore& store, const std::vector<int>& members, ofTexture* tex,
+                              bool viewMode) {
+    int n = (int)members.size();
+    uploadInstances(store, members);
+
+    bool is2D = tex && tex->getTextureData().textureTarget == GL_TEXTURE_2D;
+    ofShader& shader = is2D ? instanced2D : instancedRect;
+
+    shader.begin();
+    shader.setUniform1f("overBlack", viewMode ? 1.0f : 0.0f);
+    shader.setUniform1f("shaded", tex ? 0.0f : 1.0f);
+    shader.setUniform3f("lightDir", lightDir);
+    shader.setUniform2f("lightTerms", lightAmbient, lightDiffuse);
+    if (tex) {
+        const ofTextureData& td = tex->getTextureData();
+        shader.setUniformTexture("tex0", *tex, 0);
+        shader.setUniform1f("flipV", td.bFlipTexture ? 1.0f : 0.0f);
+        shader.setUniform2f("texSize", td.tex_t, td.tex_u);
+        shader.setUniform1f("textured", 1.0f);
+        ofSetColor(255);
+    } else {
+        // No texture: black LED base in View mode, grey fill in Designer
+        shader.setUniform1f("textured", 0.0f);
+        ofSetColor(viewMode ? 0 : 80);
+    }
+    quad.drawElementsInstanced(GL_TRIANGLES, 6, n);
+    stats.drawCalls++;
+
+    // Border outline - only in Designer mode
+    if (!viewMode) {
+        shader.setUniform1f("textured", 0.0f);
+        shader.setUniform1f("shaded", 0.0f);
+        ofSetColor(60);
+        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        quad.drawElementsInstanced(GL_TRIANGLES, 6, n);
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        stats.drawCalls++;
+    }
+
+    shader.end();
+    ofSetColor(255);
+}
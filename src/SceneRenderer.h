@@ -0,0 +1,66 @@
+#pragma once
+#include "ofMain.h"
+#include "ScreenStore.h"
+#include "ScreenShader.h"
+#include <vector>
+
+// Batching layer for Scene::draw.
+// Flat screens (no curvature, no mask) are grouped by shared source and drawn with
+// one instanced call per group: a shared unit quad plus per-instance model
+// matrix and crop rect. Curved and masked screens fall back to
+// ScreenObject::draw, with the curved grid detail picked from their projected
+// size. Draw-call counts are reported per frame.
+class SceneRenderer {
+public:
+    struct Stats {
+        int drawCalls = 0;        // GL draw calls issued for screens this frame
+        int batches = 0;          // instanced groups drawn
+        int batchedScreens = 0;   // screens drawn through a batch
+        int individualScreens = 0;// screens drawn one by one
+    };
+
+    void setup();
+    // Camera for this frame (LOD of curved screens); call before draw
+    void setCamera(const glm::mat4& projection, const glm::mat4& modelView);
+    // Directional light for solid fills (see ScreenShader::setLight)
+    void setLight(const glm::vec3& eyeDir, float ambient, float diffuse);
+    // Draws store slot i for each i in 'visible' (store already synced)
+    void draw(const ScreenStore& store, const std::vector<int>& visible, bool viewMode);
+
+    // On-screen pixels per world unit at a world point (0 = behind camera)
+    float pixelsPerUnit(const glm::vec3& worldPoint) const;
+
+    ScreenShader& getScreenShader() { return screenShader; }
+    const Stats& getStats() const { return stats; }
+
+private:
+    // Per-instance attribute locations (0-3 are oF's position/color/normal/texcoord)
+    static const int INSTANCE_MODEL = 4; // mat4 → locations 4..7
+    static const int INSTANCE_CROP  = 8;
+
+    struct Batch {
+        std::vector<int> members; // store slots
+    };
+    // [0] = no source, [id + 1] = store source id; reused across frames
+    std::vector<Batch> batches;
+
+    ScreenShader screenShader; // per-screen path (curved / masked)
+    ofShader instanced2D;
+    ofShader instancedRect;
+    ofVbo quad;                // unit quad, V=0 at top
+
+    // Instance data scratch buffers (reused across frames)
+    std::vector<glm::vec4> modelCols[4];
+    std::vector<glm::vec4> crops;
+
+    Stats stats;
+
+    glm::mat4 viewProj;
+    glm::vec3 lightDir{0, 0, 1};
+    float lightAmbient = 1.0f;
+    float lightDiffuse = 0.0f;
+    float ppuScale = 0; // viewport height * projection y-scale / 2
+
+    void uploadInstances(const ScreenStore& store, const std::vector<int>& members);
+    void drawBatch(const ScreenStore& store, const std::vector<int>& members, ofTexture* tex, bool viewMode);
+};
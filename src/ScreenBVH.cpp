@@ -0,0 +1,140 @@
+#include "win_byte_fix.h"
+#include "ScreenBVH.h"
+
+void ScreenBVH::update(const ScreenStore& store) {
+    // Same screens in the same slots → refit; anything else → rebuild
+    int n = store.size();
+    if (!built || store.getListVersion() != listVersion) {
+        itemBounds.resize(n);
+        boundsVersions.resize(n);
+        for (int i = 0; i < n; i++) {
+            itemBounds[i] = store.getBounds(i);
+            boundsVersions[i] = store.getBoundsVersion(i);
+        }
+        listVersion = store.getListVersion();
+        built = true;
+        rebuild();
+        return;
+    }
+
+    // Refit: pick up slots whose bounds the store rewrote, then only the
+    // ancestors of their leaves
+    bool anyChanged = false;
+    std::fill(nodeDirty.begin(), nodeDirty.end(), 0);
+    for (int i = 0; i < n; i++) {
+        if (store.getBoundsVersion(i) == boundsVersions[i]) continue;
+        boundsVersions[i] = store.getBoundsVersion(i);
+        itemBounds[i] = store.getBounds(i);
+        nodeDirty[leafOf[i]] = 1;
+        anyChanged = true;
+    }
+    if (!anyChanged) return;
+
+    // Children always have higher indices than their parent, so walk backwards
+    for (int n = (int)nodes.size() - 1; n >= 0; n--) {
+        Node& node = nodes[n];
+        if (node.left >= 0) {
+            if (!nodeDirty[node.left] && !nodeDirty[node.right]) continue;
+            node.box = nodes[node.left].box;
+            node.box.expand(nodes[node.right].box);
+            nodeDirty[n] = 1;
+        } else if (nodeDirty[n]) {
+            node.box = AABB();
+            for (int k = 0; k < node.count; k++) node.box.expand(itemBounds[order[node.first + k]]);
+        }
+    }
+}
+
+void ScreenBVH::rebuild() {
+    nodes.clear();
+    order.resize(itemBounds.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = (int)i;
+    leafOf.assign(itemBounds.size(), 0);
+    if (!itemBounds.empty()) {
+        nodes.reserve(itemBounds.size() * 2 / LEAF_SIZE + 1);
+        buildNode(0, (int)itemBounds.size());
+    }
+    nodeDirty.assign(nodes.size(), 0);
+}
+
+int ScreenBVH::buildNode(int first, int count) {
+    int index = (int)nodes.size();
+    nodes.emplace_back();
+
+    AABB box, centers;
+    for (int k = 0; k < count; k++) {
+        const AABB& b = itemBounds[order[first + k]];
+        box.expand(b);
+        centers.expand(b.center());
+    }
+    nodes[index].box = box;
+
+    if (count <= LEAF_SIZE) {
+        nodes[index].first = first;
+        nodes[index].count = count;
+        for (int k = 0; k < count; k++) leafOf[order[first + k]] = index;
+        return index;
+    }
+
+    // Median split along the widest axis of the centers
+    glm::vec3 extent = centers.max - centers.min;
+    int axis = (extent.y > extent.x) ? 1 : 0;
+    if (extent.z > extent[axis]) axis = 2;
+
+    int mid = first + count / 2;
+    std::nth_element(order.begin() + first, order.begin() + mid, order.begin() + first + count,
+        [&](int a, int b) { return itemBounds[a].center()[axis] < itemBounds[b].center()[axis]; });
+
+    int left = buildNode(first, mid - first);
+    int right = buildNode(mid, first + count - mid);
+    nodes[index].left = left;
+    nodes[index].right = right;
+    return index;
+}
+
+int ScreenBVH::raycast(const ScreenStore& store, const glm::vec3& origin, const glm::vec3& dir,
+                       float& tOut) const {
+    if (nodes.empty()) return -1;
+
+    glm::vec3 invDir(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+    int closest = -1;
+    float closestT = std::numeric_limits<float>::max();
+
+    int stack[64];
+    int sp = 0;
+    stack[sp++] = 0;
+    while (sp > 0) {
+        const Node& node = nodes[stack[--sp]];
+        float tBox;
+        if (!node.box.intersectRay(origin, invDir, closestT, tBox)) continue;
+
+        if (node.left < 0) {
+            for (int k = 0; k < node.count; k++) {
+                int i = order[node.first + k];
+                float t;
+                if (itemBounds[i].intersectRay(origin, invDir, closestT, tBox) &&
+                    store.getObject(i)->intersectRay(origin, dir, t) && t < closestT) {
+                    closestT = t;
+                    closest = i;
+                }
+            }
+            continue;
+        }
+
+        // Visit the nearer child first so its hit prunes the other
+        float tl, tr;
+        bool hl = nodes[node.left].box.intersectRay(origin, invDir, closestT, tl);
+        bool hr = nodes[node.right].box.intersectRay(origin, invDir, closestT, tr);
+        if (hl && hr) {
+            if (tl <= tr) { stack[sp++] = node.right; stack[sp++] = node.left; }
+            else          { stack[sp++] = node.left;  stack[sp++] = node.right; }
+        } else if (hl) {
+            stack[sp++] = node.left;
+        } else if (hr) {
+            stack[sp++] = node.right;
+        }
+    }
+
+    if (closest >= 0) tOut = closestT;
+    return closest;
+}
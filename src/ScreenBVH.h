@@ -0,0 +1,43 @@
+#pragma once
+#include "ofMain.h"
+#include "Bounds.h"
+#include "ScreenStore.h"
+#include <vector>
+#include <memory>
+
+// Bounding-volume hierarchy over the world bounds in a ScreenStore, used by
+// Scene for picking (culling and box selection scan the store's arrays
+// directly). The tree is rebuilt only when the screen list changes;
+// transform/size edits refit the affected leaves and their ancestors.
+class ScreenBVH {
+public:
+    // Bring the tree in line with the store (rebuild or refit)
+    void update(const ScreenStore& store);
+
+    // Closest screen hit by the ray (-1 if none)
+    int raycast(const ScreenStore& store, const glm::vec3& origin, const glm::vec3& dir, float& tOut) const;
+
+    const AABB& getItemBounds(int index) const { return itemBounds[index]; }
+
+private:
+    struct Node {
+        AABB box;
+        int left = -1;   // child nodes (-1 for leaves)
+        int right = -1;
+        int first = 0;   // leaf range in 'order'
+        int count = 0;
+    };
+    static const int LEAF_SIZE = 4;
+
+    std::vector<Node> nodes;                 // nodes[0] is the root; children follow parents
+    std::vector<int> order;                  // screen indices grouped by leaf
+    std::vector<AABB> itemBounds;            // world bounds per screen index
+    std::vector<uint64_t> boundsVersions;    // last seen store bounds versions
+    uint64_t listVersion = 0;                // store list version the tree was built for
+    bool built = false;
+    std::vector<int> leafOf;                 // owning leaf node per screen index
+    std::vector<char> nodeDirty;
+
+    void rebuild();
+    int buildNode(int first, int count);
+};
@@ -1,34 +1,91 @@
 #include "win_byte_fix.h"
 #include "ScreenObject.h"
+#include "MaskCache.h"
+#include <atomic>
+
+// Shared so a generation never repeats, even for a new screen at a reused address
+static std::atomic<uint64_t> nextGeneration{1};
+static std::atomic<uint64_t> nextUid{1};
 
 ScreenObject::ScreenObject(const std::string& name, float width, float height)
-    : name(name) {
-    plane.set(width, height, 2, 2);
-    plane.setPosition(0, 0, 0);
+    : name(name), uid(nextUid++), width(width), height(height) {
+    node.setPosition(0, 0, 0);
+    transformChanged();
+    shapeChanged();
 }
 
 void ScreenObject::setPosition(const glm::vec3& pos) {
-    plane.setPosition(pos);
+    node.setPosition(pos);
+    transformChanged();
 }
 
 void ScreenObject::setRotationEuler(const glm::vec3& eulerDeg) {
-    plane.setOrientation(glm::vec3(eulerDeg.x, eulerDeg.y, eulerDeg.z));
+    node.setOrientation(glm::vec3(eulerDeg.x, eulerDeg.y, eulerDeg.z));
+    transformChanged();
 }
 
 void ScreenObject::setScale(const glm::vec3& s) {
-    plane.setScale(s);
+    node.setScale(s);
+    transformChanged();
 }
 
 glm::vec3 ScreenObject::getPosition() const {
-    return plane.getPosition();
+    return node.getPosition();
 }
 
 glm::vec3 ScreenObject::getRotationEuler() const {
-    return plane.getOrientationEulerDeg();
+    if (eulerDirty) {
+        rotationEuler = node.getOrientationEulerDeg();
+        eulerDirty = false;
+    }
+    return rotationEuler;
 }
 
 glm::vec3 ScreenObject::getScale() const {
-    return plane.getScale();
+    return node.getScale();
+}
+
+void ScreenObject::setSize(float w, float h) {
+    width = w;
+    height = h;
+    maskDirty = true;
+    shapeChanged();
+}
+
+// --- Transform cache ---
+
+void ScreenObject::transformChanged() {
+    worldDirty = true;
+    inverseDirty = true;
+    eulerDirty = true;
+    transformGeneration = nextGeneration++;
+    if (journal) journal->record(SceneEvent::TransformChanged, uid);
+}
+
+void ScreenObject::shapeChanged(SceneEvent::Type type) {
+    shapeGeneration = nextGeneration++;
+    if (journal) journal->record(type, uid);
+}
+
+void ScreenObject::contentChanged(SceneEvent::Type type) {
+    contentGeneration = nextGeneration++;
+    if (journal) journal->record(type, uid);
+}
+
+const glm::mat4& ScreenObject::getWorldMatrix() const {
+    if (worldDirty) {
+        worldMatrix = node.getGlobalTransformMatrix();
+        worldDirty = false;
+    }
+    return worldMatrix;
+}
+
+const glm::mat4& ScreenObject::getInverseWorldMatrix() const {
+    if (inverseDirty) {
+        inverseWorldMatrix = glm::inverse(getWorldMatrix());
+        inverseDirty = false;
+    }
+    return inverseWorldMatrix;
 }
 
 // --- Curvature ---
@@ -36,19 +93,45 @@ glm::vec3 ScreenObject::getScale() const {
 void ScreenObject::setCurvature(float deg) {
     deg = ofClamp(deg, -180, 180);
     if (std::abs(curvature - deg) < 0.001f) return;
-    curvature = deg;
-    rebuildMesh();
+    curvature = deg; // bent in the vertex shader, nothing to rebuild
+    shapeChanged();
 }
 
 float ScreenObject::getCurvature() const {
     return curvature;
 }
 
+void ScreenObject::setCurveAxis(CurveAxis axis) {
+    if (curveAxis == axis) return;
+    curveAxis = axis;
+    shapeChanged();
+}
+
+CurveAxis ScreenObject::getCurveAxis() const {
+    return curveAxis;
+}
+
+static std::string curveAxisToString(CurveAxis a) {
+    switch (a) {
+        case CurveAxis::Horizontal: return "horizontal";
+        case CurveAxis::Vertical:   return "vertical";
+        case CurveAxis::Spherical:  return "spherical";
+    }
+    return "horizontal";
+}
+
+static CurveAxis curveAxisFromString(const std::string& s) {
+    if (s == "vertical")  return CurveAxis::Vertical;
+    if (s == "spherical") return CurveAxis::Spherical;
+    return CurveAxis::Horizontal;
+}
+
 // --- Crop ---
 
 void ScreenObject::setCropRect(const ofRectangle& r) {
+    // Crop is a shader uniform — mesh UVs stay normalized, nothing to rebuild
     cropRect = r;
-    rebuildMesh();
+    contentChanged(SceneEvent::CropChanged);
 }
 
 const ofRectangle& ScreenObject::getCropRect() const {
@@ -59,7 +142,8 @@ const ofRectangle& ScreenObject::getCropRect() const {
 
 void ScreenObject::setMask(const std::vector<glm::vec2>& points) {
     maskPoints = points;
-    rebuildPolygonMesh();
+    maskDirty = true;
+    shapeChanged(SceneEvent::MaskChanged);
 }
 
 const std::vector<glm::vec2>& ScreenObject::getMaskPoints() const {
@@ -75,8 +159,8 @@ bool ScreenObject::hasMask() const {
 ofJson ScreenObject::toJson() const {
     ofJson j;
     j["name"] = name;
-    j["width"] = plane.getWidth();
-    j["height"] = plane.getHeight();
+    j["width"] = width;
+    j["height"] = height;
 
     auto pos = getPosition();
     j["position"] = {pos.x, pos.y, pos.z};
@@ -88,6 +172,9 @@ ofJson ScreenObject::toJson() const {
     j["scale"] = {sc.x, sc.y, sc.z};
 
     j["curvature"] = curvature;
+    if (curveAxis != CurveAxis::Horizontal) {
+        j["curveAxis"] = curveAxisToString(curveAxis);
+    }
 
     j["crop"] = {
         {"x", cropRect.x},
@@ -116,7 +203,8 @@ void ScreenObject::fromJson(const ofJson& j) {
 
     float w = j.value("width", 320.0f);
     float h = j.value("height", 180.0f);
-    plane.set(w, h, 2, 2);
+    width = w;
+    height = h;
 
     if (j.contains("position") && j["position"].is_array() && j["position"].size() >= 3) {
         setPosition(glm::vec3(j["position"][0], j["position"][1], j["position"][2]));
@@ -130,7 +218,11 @@ void ScreenObject::fromJson(const ofJson& j) {
         setScale(glm::vec3(j["scale"][0], j["scale"][1], j["scale"][2]));
     }
 
-    setCurvature(j.value("curvature", 0.0f));
+    // Size only flags the mask texture; it is fetched once on next use
+    curvature = ofClamp(j.value("curvature", 0.0f), -180, 180);
+    curveAxis = curveAxisFromString(j.value("curveAxis", std::string("horizontal")));
+    maskDirty = true;
+    shapeChanged();
 
     if (j.contains("crop")) {
         auto& c = j["crop"];
@@ -140,190 +232,71 @@ void ScreenObject::fromJson(const ofJson& j) {
             c.value("w", 1.0f),
             c.value("h", 1.0f)
         ));
+    } else {
+        setCropRect(ofRectangle(0, 0, 1, 1));
     }
 
-    if (j.contains("sourceName")) {
-        sourceName = j["sourceName"].get<std::string>();
-    }
+    // Absent keys mean "none" so fromJson can also be applied in place (undo)
+    sourceName = j.value("sourceName", std::string());
 
+    std::vector<glm::vec2> pts;
     if (j.contains("mask") && j["mask"].is_array()) {
-        std::vector<glm::vec2> pts;
         for (auto& pt : j["mask"]) {
             if (pt.is_array() && pt.size() >= 2) {
                 pts.push_back(glm::vec2(pt[0], pt[1]));
             }
         }
-        if (pts.size() >= 3) {
-            setMask(pts);
-        }
+        if (pts.size() < 3) pts.clear();
     }
+    maskPoints = std::move(pts);
+    contentChanged(SceneEvent::MaskChanged);
 }
 
-void ScreenObject::rebuildPolygonMesh() {
-    polygonMesh.clear();
-    if (maskPoints.size() < 3) return;
-
-    float w = plane.getWidth();
-    float h = plane.getHeight();
-
-    // Use ofPath to tessellate the polygon
-    ofPath path;
-    path.setFilled(true);
-    // maskPoints are normalized 0-1, convert to local coords centered on origin
-    path.moveTo((maskPoints[0].x - 0.5f) * w, (0.5f - maskPoints[0].y) * h);
-    for (size_t i = 1; i < maskPoints.size(); i++) {
-        path.lineTo((maskPoints[i].x - 0.5f) * w, (0.5f - maskPoints[i].y) * h);
-    }
-    path.close();
-
-    ofMesh tess = path.getTessellation();
-
-    // Build VBO mesh with tex coords
-    polygonMesh.setMode(OF_PRIMITIVE_TRIANGLES);
-    auto& verts = tess.getVertices();
-    auto& indices = tess.getIndices();
-
-    for (auto& v : verts) {
-        polygonMesh.addVertex(glm::vec3(v.x, v.y, 0));
-        // Compute normalized UV from vertex position
-        float u = (v.x / w) + 0.5f;
-        float s = 0.5f - (v.y / h);
-        float cu = cropRect.x + u * cropRect.width;
-        float cv = cropRect.y + s * cropRect.height;
-        polygonMesh.addTexCoord(glm::vec2(cu, cv));
-        polygonMesh.addNormal(glm::vec3(0, 0, 1));
-    }
-
-    for (auto& idx : indices) {
-        polygonMesh.addIndex(idx);
-    }
-}
-
-// --- Mesh rebuild ---
-
-void ScreenObject::rebuildMesh() {
-    curvedMesh.clear();
-    curvedMesh.setMode(OF_PRIMITIVE_TRIANGLES);
-
-    float w = plane.getWidth();
-    float h = plane.getHeight();
-    float absCurv = std::abs(curvature);
-    float sign = (curvature >= 0) ? 1.0f : -1.0f;
-    float totalAngle = absCurv * DEG_TO_RAD;
-
-    int cols = meshColumns;
-    int rows = meshRows;
-
-    // Generate vertices
-    for (int j = 0; j <= rows; j++) {
-        float s = (float)j / rows;  // 0 to 1
-        float y = (s - 0.5f) * h;
-
-        for (int i = 0; i <= cols; i++) {
-            float t = (float)i / cols;  // 0 to 1
-
-            float x, z;
-            if (absCurv > 0.1f) {
-                float radius = (w / 2.0f) / sin(totalAngle / 2.0f);
-                float angle = (t - 0.5f) * totalAngle;
-                x = radius * sin(angle);
-                z = sign * radius * (cos(angle) - cos(totalAngle / 2.0f));
-            } else {
-                x = (t - 0.5f) * w;
-                z = 0;
+// --- Lazy geometry ---
+
+void ScreenObject::ensureGeometry() const {
+    // Setters only flag; a burst of edits between frames costs one lookup.
+    // The mask texture depends on the contour and the plane's aspect only,
+    // so curvature changes never touch it.
+    if (maskDirty) {
+        mask = maskPoints.empty() ? nullptr
+             : MaskCache::get().acquire(maskPoints, height > 0 ? width / height : 1.0f);
+        // Outline in the grid's space (V down → y up). Edges are split as
+        // finely as the densest grid so they follow any curvature.
+        maskOutline.clear();
+        for (size_t i = 0; i < maskPoints.size(); i++) {
+            glm::vec2 a = maskPoints[i];
+            glm::vec2 b = maskPoints[(i + 1) % maskPoints.size()];
+            int steps = std::max(1, (int)std::ceil(glm::length(b - a) * ScreenShader::MAX_SEGMENTS));
+            for (int k = 0; k < steps; k++) {
+                glm::vec2 p = glm::mix(a, b, (float)k / steps);
+                maskOutline.addVertex(p.x - 0.5f, 0.5f - p.y, 0);
             }
-
-            curvedMesh.addVertex(glm::vec3(x, y, z));
-
-            // Tex coords: placeholder (updated before draw with actual texture size)
-            // Use (1-s) because j=0 is bottom (y=-h/2) and V=0 should be top
-            float texU = cropRect.x + t * cropRect.width;
-            float texV = cropRect.y + (1.0f - s) * cropRect.height;
-            curvedMesh.addTexCoord(glm::vec2(texU, texV));
-
-            // Normal: pointing outward from arc
-            if (absCurv > 0.1f) {
-                float radius = (w / 2.0f) / sin(totalAngle / 2.0f);
-                float angle = (t - 0.5f) * totalAngle;
-                glm::vec3 normal = glm::normalize(glm::vec3(sin(angle), 0, sign * cos(angle)));
-                curvedMesh.addNormal(normal);
-            } else {
-                curvedMesh.addNormal(glm::vec3(0, 0, 1));
-            }
-        }
-    }
-
-    // Generate indices
-    for (int j = 0; j < rows; j++) {
-        for (int i = 0; i < cols; i++) {
-            int topLeft = j * (cols + 1) + i;
-            int topRight = topLeft + 1;
-            int bottomLeft = (j + 1) * (cols + 1) + i;
-            int bottomRight = bottomLeft + 1;
-
-            curvedMesh.addIndex(topLeft);
-            curvedMesh.addIndex(bottomLeft);
-            curvedMesh.addIndex(topRight);
-
-            curvedMesh.addIndex(topRight);
-            curvedMesh.addIndex(bottomLeft);
-            curvedMesh.addIndex(bottomRight);
         }
+        maskOutline.close();
+        maskDirty = false;
     }
 }
 
 // --- Video Source (Syphon / Spout) ---
 
-#ifdef TARGET_OSX
-void ScreenObject::connectToSource(const ofxSyphonServerDescription& desc) {
-    if (!clientSetup) {
-        client.setup();
-        clientSetup = true;
-    }
-    client.set(desc);
-    sourceIndex = 0; // mark as connected
-    sourceName = desc.appName + " - " + desc.serverName;
-    ofLogNotice("ScreenObject") << name << " connected to: " << sourceName;
-}
-#elif defined(TARGET_WIN32)
-void ScreenObject::connectToSource(const std::string& senderName) {
-    if (spoutSetup) {
-        spoutReceiver.release();
-        spoutSetup = false;
-    }
-    spoutTexture.clear(); // force re-allocate on next receive
-    if (spoutReceiver.init(senderName)) {
-        spoutSetup = true;
-        sourceIndex = 0; // mark as connected
-        sourceName = senderName;
-        ofLogNotice("ScreenObject") << name << " connected to Spout: " << sourceName;
-    } else {
-        ofLogError("ScreenObject") << name << " failed to init Spout receiver for: " << senderName;
+void ScreenObject::connectToSource(std::shared_ptr<SharedSource> src) {
+    source = std::move(src);
+    contentChanged(SceneEvent::SourceChanged);
+    if (!source) {
         sourceIndex = -1;
         sourceName = "";
+        return;
     }
+    sourceIndex = 0; // mark as connected
+    sourceName = source->getName();
 }
 
-void ScreenObject::updateSpout() {
-    if (spoutSetup && hasSource()) {
-        spoutReceiver.receive(spoutTexture);
-    }
-}
-#endif
-
 void ScreenObject::disconnectSource() {
-#ifdef TARGET_OSX
-    if (clientSetup) {
-        client.set("", "");
-    }
-#elif defined(TARGET_WIN32)
-    if (spoutSetup) {
-        spoutReceiver.release();
-        spoutSetup = false;
-    }
-#endif
+    source.reset(); // receiver closes when the last screen releases it
     sourceIndex = -1;
     sourceName = "";
+    contentChanged(SceneEvent::SourceChanged);
 }
 
 bool ScreenObject::hasSource() const {
@@ -332,270 +305,251 @@ bool ScreenObject::hasSource() const {
 
 // --- Drawing ---
 
-// Helper: which mesh to use
-// Returns 0=flat plane, 1=curved mesh, 2=polygon mesh
-static int meshMode(bool hasMask, float curvature) {
-    if (hasMask) return 2;
-    if (std::abs(curvature) > 0.1f) return 1;
-    return 0;
-}
-
-void ScreenObject::draw(bool viewMode) {
-    bool textured = false;
-    int mode = meshMode(!maskPoints.empty(), curvature);
-
-    // Helper lambda: draw the current mesh (flat/curved/polygon)
-    auto drawMesh = [&]() {
-        if (mode == 2) {
-            ofPushMatrix();
-            ofMultMatrix(plane.getGlobalTransformMatrix());
-            polygonMesh.draw();
-            ofPopMatrix();
-        } else if (mode == 1) {
-            ofPushMatrix();
-            ofMultMatrix(plane.getGlobalTransformMatrix());
-            curvedMesh.draw();
-            ofPopMatrix();
-        } else {
-            plane.draw();
-        }
-    };
-
-    // In View mode, draw solid black base first (like a real LED panel —
-    // alpha in the Syphon source will composite against black, not transparent)
-    if (viewMode) {
-        ofSetColor(0);
-        drawMesh();
-    }
+CurveParams ScreenObject::getCurveParams() const {
+    return CurveParams::compute(width, height, curvature, curveAxis);
+}
 
-    // Draw video source texture on top
-#ifdef TARGET_OSX
-    if (hasSource() && clientSetup) {
-        if (client.lockTexture()) {
-            // Allow texture to pass depth test at same Z as the black base
-            if (viewMode) glDepthFunc(GL_LEQUAL);
-            ofTexture& tex = client.getTexture();
-            bool flipped = tex.getTextureData().bFlipTexture;
-
-            if (mode == 1) {
-                // Curved mesh - update tex coords
-                // Note: j=0 → y=-h/2 (bottom), so use (1-s) to match flat plane's V mapping
-                auto& texCoords = curvedMesh.getTexCoords();
-                int cols = meshColumns;
-                int rows = meshRows;
-                for (int j = 0; j <= rows; j++) {
-                    float s = (float)j / rows;
-                    for (int i = 0; i <= cols; i++) {
-                        float t = (float)i / cols;
-                        float cu = cropRect.x + t * cropRect.width;
-                        float cv = cropRect.y + (1.0f - s) * cropRect.height;
-                        if (flipped) cv = 1.0f - cv;
-                        texCoords[j * (cols + 1) + i] = tex.getCoordFromPercent(cu, cv);
-                    }
-                }
-
-                tex.bind();
-                ofSetColor(255);
-                drawMesh();
-                tex.unbind();
-            } else if (mode == 2) {
-                // Polygon mesh - update tex coords from vertex positions
-                auto& texCoords = polygonMesh.getTexCoords();
-                auto& verts = polygonMesh.getVertices();
-                float pw = plane.getWidth();
-                float ph = plane.getHeight();
-                for (size_t i = 0; i < texCoords.size(); i++) {
-                    float u = (verts[i].x / pw) + 0.5f;
-                    float v = 0.5f - (verts[i].y / ph);
-                    float cu = cropRect.x + u * cropRect.width;
-                    float cv = cropRect.y + v * cropRect.height;
-                    if (flipped) cv = 1.0f - cv;
-                    texCoords[i] = tex.getCoordFromPercent(cu, cv);
-                }
-
-                tex.bind();
-                ofSetColor(255);
-                drawMesh();
-                tex.unbind();
-            } else {
-                // Flat plane
-                auto& mesh = plane.getMesh();
-                auto& texCoords = mesh.getTexCoords();
-                auto& verts = mesh.getVertices();
-                float pw = plane.getWidth();
-                float ph = plane.getHeight();
-
-                for (size_t i = 0; i < texCoords.size(); i++) {
-                    float u = (verts[i].x / pw) + 0.5f;
-                    float v = 0.5f - (verts[i].y / ph);
-                    float cu = cropRect.x + u * cropRect.width;
-                    float cv = cropRect.y + v * cropRect.height;
-                    if (flipped) cv = 1.0f - cv;
-                    texCoords[i] = tex.getCoordFromPercent(cu, cv);
-                }
-
-                tex.bind();
-                ofSetColor(255);
-                drawMesh();
-                tex.unbind();
-            }
+bool ScreenObject::isFlat() const {
+    return maskPoints.empty() && getCurveParams().mode == 0;
+}
 
-            if (viewMode) glDepthFunc(GL_LESS); // restore default
-            textured = true;
-            client.unlockTexture();
-        }
+// Bind geometry uniforms and draw the screen's grid once
+void ScreenObject::drawGeometry(ScreenShader& shader, const CurveParams& curve, float pixelsPerUnit) {
+    int cols = 1, rows = 1;
+    if (curve.mode == 1 || curve.mode == 3) {
+        cols = ScreenShader::segmentsFor(curve.radius, curve.halfAngleH * 2.0f, pixelsPerUnit);
     }
-#elif defined(TARGET_WIN32)
-    if (hasSource() && spoutSetup && spoutTexture.isAllocated()) {
-        if (viewMode) glDepthFunc(GL_LEQUAL);
-        ofTexture& tex = spoutTexture;
-        bool flipped = tex.getTextureData().bFlipTexture;
-
-        if (mode == 1) {
-            auto& texCoords = curvedMesh.getTexCoords();
-            int cols = meshColumns;
-            int rows = meshRows;
-            for (int j = 0; j <= rows; j++) {
-                float s = (float)j / rows;
-                for (int i = 0; i <= cols; i++) {
-                    float t = (float)i / cols;
-                    float cu = cropRect.x + t * cropRect.width;
-                    float cv = cropRect.y + (1.0f - s) * cropRect.height;
-                    if (flipped) cv = 1.0f - cv;
-                    texCoords[j * (cols + 1) + i] = tex.getCoordFromPercent(cu, cv);
-                }
-            }
-            tex.bind();
-            ofSetColor(255);
-            drawMesh();
-            tex.unbind();
-        } else if (mode == 2) {
-            auto& texCoords = polygonMesh.getTexCoords();
-            auto& verts = polygonMesh.getVertices();
-            float pw = plane.getWidth();
-            float ph = plane.getHeight();
-            for (size_t i = 0; i < texCoords.size(); i++) {
-                float u = (verts[i].x / pw) + 0.5f;
-                float v = 0.5f - (verts[i].y / ph);
-                float cu = cropRect.x + u * cropRect.width;
-                float cv = cropRect.y + v * cropRect.height;
-                if (flipped) cv = 1.0f - cv;
-                texCoords[i] = tex.getCoordFromPercent(cu, cv);
-            }
-            tex.bind();
-            ofSetColor(255);
-            drawMesh();
-            tex.unbind();
-        } else {
-            auto& mesh = plane.getMesh();
-            auto& texCoords = mesh.getTexCoords();
-            auto& verts = mesh.getVertices();
-            float pw = plane.getWidth();
-            float ph = plane.getHeight();
-            for (size_t i = 0; i < texCoords.size(); i++) {
-                float u = (verts[i].x / pw) + 0.5f;
-                float v = 0.5f - (verts[i].y / ph);
-                float cu = cropRect.x + u * cropRect.width;
-                float cv = cropRect.y + v * cropRect.height;
-                if (flipped) cv = 1.0f - cv;
-                texCoords[i] = tex.getCoordFromPercent(cu, cv);
-            }
-            tex.bind();
-            ofSetColor(255);
-            drawMesh();
-            tex.unbind();
-        }
+    if (curve.mode == 2 || curve.mode == 3) {
+        rows = ScreenShader::segmentsFor(curve.radius, curve.halfAngleV * 2.0f, pixelsPerUnit);
+    }
+    if (!grid || grid->getColumns() != cols || grid->getRows() != rows) {
+        grid = MeshPool::get().acquire(cols, rows);
+    }
+    shader.setGeometry(width, height, curve);
+    grid->draw();
+}
 
-        if (viewMode) glDepthFunc(GL_LESS);
-        textured = true;
+// Border in the current color: the mask contour when masked, else the grid
+// edges. Expects the shader bound and untextured.
+void ScreenObject::drawOutline(ScreenShader& shader, const CurveParams& curve, float pixelsPerUnit) {
+    if (hasMask()) {
+        shader.setMask(nullptr);
+        shader.setGeometry(width, height, curve);
+        maskOutline.draw();
+        return;
     }
-#endif
+    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    drawGeometry(shader, curve, pixelsPerUnit);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+}
+
+int ScreenObject::draw(ScreenShader& shader, bool viewMode, float pixelsPerUnit) {
+    ensureGeometry();
+    int drawCalls = 0;
+    CurveParams curve = getCurveParams();
 
-    // No texture: solid fill (only if black base wasn't already drawn in view mode)
-    if (!textured && !viewMode) {
-        ofSetColor(80);
-        drawMesh();
+    ofPushMatrix();
+    ofMultMatrix(getWorldMatrix());
+
+    // One fill pass: the source texture (composited over black in View mode,
+    // like a real LED panel), or a solid fill when there is no frame
+    ofTexture* tex = lockSourceTexture();
+    shader.begin(tex, cropRect, viewMode);
+    shader.setMask(mask ? &mask->getTexture() : nullptr);
+    if (tex) {
+        ofSetColor(255);
+    } else {
+        ofSetColor(viewMode ? 0 : 80);
     }
+    drawGeometry(shader, curve, pixelsPerUnit);
+    drawCalls++;
 
     // Border outline - only in Designer mode
     if (!viewMode) {
+        shader.setTextured(false);
         ofSetColor(60);
-        ofNoFill();
-        if (mode == 2) {
-            ofPushMatrix();
-            ofMultMatrix(plane.getGlobalTransformMatrix());
-            polygonMesh.drawWireframe();
-            ofPopMatrix();
-        } else if (mode == 1) {
-            ofPushMatrix();
-            ofMultMatrix(plane.getGlobalTransformMatrix());
-            curvedMesh.drawWireframe();
-            ofPopMatrix();
-        } else {
-            plane.drawWireframe();
-        }
-        ofFill();
+        drawOutline(shader, curve, pixelsPerUnit);
+        drawCalls++;
     }
+
+    shader.end();
+    if (tex) unlockSourceTexture();
+    ofPopMatrix();
     ofSetColor(255);
+    return drawCalls;
 }
 
-void ScreenObject::drawSelected() {
-    int mode = meshMode(!maskPoints.empty(), curvature);
+void ScreenObject::drawSelected(ScreenShader& shader, float pixelsPerUnit) {
+    ensureGeometry();
+    CurveParams curve = getCurveParams();
+
+    ofPushMatrix();
+    ofMultMatrix(getWorldMatrix());
+    shader.begin(nullptr, cropRect);
+    shader.setTextured(false);
     ofSetColor(0, 200, 255);
-    ofNoFill();
-    if (mode == 2) {
-        ofPushMatrix();
-        ofMultMatrix(plane.getGlobalTransformMatrix());
-        polygonMesh.drawWireframe();
-        ofPopMatrix();
-    } else if (mode == 1) {
-        ofPushMatrix();
-        ofMultMatrix(plane.getGlobalTransformMatrix());
-        curvedMesh.drawWireframe();
-        ofPopMatrix();
-    } else {
-        plane.drawWireframe();
-    }
-    ofFill();
+    drawOutline(shader, curve, pixelsPerUnit);
+    shader.end();
+    ofPopMatrix();
     ofSetColor(255);
 }
 
 bool ScreenObject::drawSourceTexture(const ofRectangle& destRect) {
-#ifdef TARGET_OSX
-    if (hasSource() && clientSetup) {
-        if (client.lockTexture()) {
-            ofTexture& tex = client.getTexture();
-            ofSetColor(255);
-            tex.draw(destRect.x, destRect.y, destRect.width, destRect.height);
-            client.unlockTexture();
-            return true;
-        }
-    }
-#elif defined(TARGET_WIN32)
-    if (hasSource() && spoutSetup && spoutTexture.isAllocated()) {
+    if (ofTexture* tex = lockSourceTexture()) {
         ofSetColor(255);
-        spoutTexture.draw(destRect.x, destRect.y, destRect.width, destRect.height);
+        tex->draw(destRect.x, destRect.y, destRect.width, destRect.height);
+        unlockSourceTexture();
         return true;
     }
-#endif
     return false;
 }
 
+ofTexture* ScreenObject::lockSourceTexture() {
+    if (hasSource() && source) {
+        return source->lock();
+    }
+    return nullptr;
+}
+
+void ScreenObject::unlockSourceTexture() {
+    if (source) source->unlock();
+}
+
 // --- Picking support ---
 
+void ScreenObject::getLocalBounds(glm::vec3& outMin, glm::vec3& outMax) const {
+    float w = width;
+    float h = height;
+    CurveParams curve = getCurveParams();
+
+    if (curve.mode == 0) {
+        if (maskPoints.empty()) {
+            outMin = glm::vec3(-w * 0.5f, -h * 0.5f, 0);
+            outMax = glm::vec3( w * 0.5f,  h * 0.5f, 0);
+            return;
+        }
+        // Mask contour (normalized, V down) → plane-local coords
+        outMin = glm::vec3(std::numeric_limits<float>::max());
+        outMax = glm::vec3(-std::numeric_limits<float>::max());
+        for (auto& pt : maskPoints) {
+            glm::vec3 v((pt.x - 0.5f) * w, (0.5f - pt.y) * h, 0);
+            outMin = glm::min(outMin, v);
+            outMax = glm::max(outMax, v);
+        }
+        return;
+    }
+
+    // Curved (a mask only clips it, the full arc stays a valid bound).
+    // Curved-axis edges sit at z=0, the middle bulges by the sagitta;
+    // spherical corners also dip behind z=0
+    outMin = glm::vec3(-w * 0.5f, -h * 0.5f, 0);
+    outMax = glm::vec3( w * 0.5f,  h * 0.5f, 0);
+    float bulge = 0, dip = 0;
+    if (curve.mode == 1) bulge = curve.radius * (1.0f - cos(curve.halfAngleH));
+    if (curve.mode == 2) bulge = curve.radius * (1.0f - cos(curve.halfAngleV));
+    if (curve.mode == 3) {
+        bulge = curve.radius * (1.0f - cos(curve.halfAngleH));
+        dip = curve.radius * cos(curve.halfAngleH) * (1.0f - cos(curve.halfAngleV));
+    }
+    float zHi = bulge, zLo = -dip;
+    outMin.z = std::min(curve.sign * zHi, curve.sign * zLo);
+    outMax.z = std::max(curve.sign * zHi, curve.sign * zLo);
+}
+
+// Even-odd test in the mask's normalized space (same rule as the rasterizer)
+static bool insideMask(const std::vector<glm::vec2>& contour, const glm::vec2& uv) {
+    if (contour.empty()) return true;
+    bool inside = false;
+    for (size_t i = 0, j = contour.size() - 1; i < contour.size(); j = i++) {
+        const glm::vec2& a = contour[i];
+        const glm::vec2& b = contour[j];
+        if ((a.y <= uv.y) != (b.y <= uv.y) &&
+            uv.x < a.x + (uv.y - a.y) * (b.x - a.x) / (b.y - a.y)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+// Ray vs the arc surface of a curved screen, analytically: a cylinder (axis
+// along local Y or X) or a sphere, clipped to the screen's angular extent
+// and its mask
+static bool intersectCurve(const CurveParams& c, float w, float h, const std::vector<glm::vec2>& maskPoints,
+                           const glm::vec3& o, const glm::vec3& d, float& tOut) {
+    float halfMain = (c.mode == 2) ? c.halfAngleV : c.halfAngleH;
+    glm::vec3 center(0, 0, -c.sign * c.radius * cos(halfMain));
+
+    // Work relative to the arc center; cylinders ignore their axis component
+    glm::vec3 oc = o - center;
+    glm::vec3 axisMask(c.mode == 2 ? 0.0f : 1.0f, c.mode == 1 ? 0.0f : 1.0f, 1.0f);
+    glm::vec3 om = oc * axisMask, dm = d * axisMask;
+
+    float A = glm::dot(dm, dm);
+    if (A < 1e-12f) return false;
+    float B = 2.0f * glm::dot(om, dm);
+    float C = glm::dot(om, om) - c.radius * c.radius;
+    float disc = B * B - 4 * A * C;
+    if (disc < 0) return false;
+    float sq = sqrt(disc);
+    float roots[2] = { (-B - sq) / (2 * A), (-B + sq) / (2 * A) };
+
+    for (float t : roots) {
+        if (t < 0) continue;
+        glm::vec3 p = oc + d * t;
+        glm::vec2 uv; // screen UV of the hit, V=0 at the top
+        if (c.mode == 1) {
+            float a = atan2(p.x, c.sign * p.z);
+            if (std::abs(a) > c.halfAngleH || std::abs(p.y) > h * 0.5f) continue;
+            uv = glm::vec2(a / (2.0f * c.halfAngleH) + 0.5f, 0.5f - p.y / h);
+        } else if (c.mode == 2) {
+            float a = atan2(p.y, c.sign * p.z);
+            if (std::abs(a) > c.halfAngleV || std::abs(p.x) > w * 0.5f) continue;
+            uv = glm::vec2(p.x / w + 0.5f, 0.5f - a / (2.0f * c.halfAngleV));
+        } else {
+            float f = asin(ofClamp(p.y / c.radius, -1.0f, 1.0f));
+            float a = atan2(p.x, c.sign * p.z);
+            if (std::abs(a) > c.halfAngleH || std::abs(f) > c.halfAngleV) continue;
+            uv = glm::vec2(a / (2.0f * c.halfAngleH) + 0.5f, 0.5f - f / (2.0f * c.halfAngleV));
+        }
+        if (insideMask(maskPoints, uv)) {
+            tOut = t;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ScreenObject::intersectRay(const glm::vec3& origin, const glm::vec3& dir, float& t) const {
+    // Unnormalized local direction keeps t identical to the world ray parameter
+    const glm::mat4& inv = getInverseWorldMatrix();
+    glm::vec3 o = glm::vec3(inv * glm::vec4(origin, 1.0f));
+    glm::vec3 d = glm::vec3(inv * glm::vec4(dir, 0.0f));
+    float w = width;
+    float h = height;
+
+    CurveParams curve = getCurveParams();
+    if (curve.mode != 0) return intersectCurve(curve, w, h, maskPoints, o, d, t);
+
+    if (std::abs(d.z) < 1e-9f) return false;
+    t = -o.z / d.z;
+    if (t < 0) return false;
+    glm::vec3 hit = o + d * t;
+    if (std::abs(hit.x) > w * 0.5f || std::abs(hit.y) > h * 0.5f) return false;
+    return insideMask(maskPoints, glm::vec2(hit.x / w + 0.5f, 0.5f - hit.y / h));
+}
+
 glm::vec3 ScreenObject::getWorldNormal() const {
-    return glm::normalize(glm::vec3(
-        plane.getGlobalTransformMatrix() * glm::vec4(0, 0, 1, 0)));
+    return glm::normalize(glm::vec3(getWorldMatrix()[2]));
 }
 
 glm::vec3 ScreenObject::getWorldCenter() const {
-    return glm::vec3(plane.getGlobalTransformMatrix() * glm::vec4(0, 0, 0, 1));
+    return glm::vec3(getWorldMatrix()[3]);
 }
 
 float ScreenObject::getPlaneWidth() const {
-    return plane.getWidth();
+    return width;
 }
 
 float ScreenObject::getPlaneHeight() const {
-    return plane.getHeight();
+    return height;
 }
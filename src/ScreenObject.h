@@ -1,19 +1,20 @@
 #pragma once
 #include "ofMain.h"
+#include "ScreenShader.h"
+#include "MaskCache.h"
+#include "MeshPool.h"
+#include "SourceRegistry.h"
+#include "SceneJournal.h"
 #include <string>
-
-#ifdef TARGET_OSX
-#include "ofxSyphon.h"
-#elif defined(TARGET_WIN32)
-#include "ofxSpout.h"
-#endif
+#include <memory>
+#include <cstdint>
 
 class ScreenObject {
 public:
     ScreenObject(const std::string& name = "Screen", float width = 320.0f, float height = 180.0f);
 
     std::string name;
-    ofPlanePrimitive plane;
+    uint64_t uid;           // stable runtime identity (undo history); not saved
 
     // Transform convenience
     void setPosition(const glm::vec3& pos);
@@ -23,69 +24,121 @@ public:
     glm::vec3 getRotationEuler() const;
     glm::vec3 getScale() const;
 
-    // Curvature
+    // Plane size (the mask texture follows the aspect)
+    void setSize(float width, float height);
+
+    // Cached global transform and inverse, recomputed on first use after a
+    // setPosition/setRotationEuler/setScale
+    const glm::mat4& getWorldMatrix() const;
+    const glm::mat4& getInverseWorldMatrix() const;
+
+    // Change counters (unique across screens) so other systems can skip work:
+    // transform = position/rotation/scale, shape = size/curvature/mask
+    uint64_t getTransformGeneration() const { return transformGeneration; }
+    uint64_t getShapeGeneration() const { return shapeGeneration; }
+    // Moves on any saved-state change (transform, shape, crop, source)
+    uint64_t getRevision() const {
+        return std::max(transformGeneration, std::max(shapeGeneration, contentGeneration));
+    }
+
+    // Set by Scene while the screen is in it; every edit is recorded there
+    void setJournal(SceneJournal* j) { journal = j; }
+
+    // Curvature (degrees of arc across the chosen axis)
     void setCurvature(float deg);
     float getCurvature() const;
+    void setCurveAxis(CurveAxis axis);
+    CurveAxis getCurveAxis() const;
+    CurveParams getCurveParams() const;
 
     // Input mapping (crop) - normalized 0-1
     void setCropRect(const ofRectangle& r);
     const ofRectangle& getCropRect() const;
 
-    // Per-screen video source (Syphon on macOS, Spout on Windows)
+    // Per-screen video source (Syphon on macOS, Spout on Windows).
+    // The receiver itself is shared through Scene's SourceRegistry.
     int sourceIndex = -1;
     std::string sourceName;
 
-#ifdef TARGET_OSX
-    void connectToSource(const ofxSyphonServerDescription& desc);
-#elif defined(TARGET_WIN32)
-    void connectToSource(const std::string& senderName);
-    void updateSpout(); // call each frame to receive texture
-#endif
+    void connectToSource(std::shared_ptr<SharedSource> src);
     void disconnectSource();
     bool hasSource() const;
+    SharedSource* getSource() const { return source.get(); }
 
     // Polygon mask (normalized 0-1 contour points)
     void setMask(const std::vector<glm::vec2>& points);
     const std::vector<glm::vec2>& getMaskPoints() const;
     bool hasMask() const;
 
-    // JSON serialization
+    // JSON serialization. fromJson only records sourceName; the owner
+    // reconnects (Scene::reconnectSource) if it changed.
     ofJson toJson() const;
     void fromJson(const ofJson& j);
 
-    // Drawing
-    void draw(bool viewMode = false);
-    void drawSelected();
+    // True when drawn as the plain plane (no curvature, no mask) — batchable
+    bool isFlat() const;
+
+    // Fetch the mask texture if an edit flagged it (draw calls this; the
+    // loader calls it on worker threads so rasterizing is off the frame)
+    void ensureGeometry() const;
+
+    // Drawing (returns the number of draw calls issued). pixelsPerUnit is the
+    // on-screen scale at the screen's depth and picks the curved grid LOD.
+    int draw(ScreenShader& shader, bool viewMode = false, float pixelsPerUnit = 0);
+    void drawSelected(ScreenShader& shader, float pixelsPerUnit = 0);
     bool drawSourceTexture(const ofRectangle& destRect); // for mapping editor
 
+    // Borrow the current source frame (nullptr if none).
+    // Every non-null result must be released with unlockSourceTexture().
+    ofTexture* lockSourceTexture();
+    void unlockSourceTexture();
+
     // Picking support
+    // Local-space bounds of the drawn geometry (curve depth, mask extent)
+    void getLocalBounds(glm::vec3& outMin, glm::vec3& outMax) const;
+    // Exact ray test against the drawn surface and mask; t is the world-space ray parameter
+    bool intersectRay(const glm::vec3& origin, const glm::vec3& dir, float& t) const;
     glm::vec3 getWorldNormal() const;
     glm::vec3 getWorldCenter() const;
     float getPlaneWidth() const;
     float getPlaneHeight() const;
 
 private:
-    // Curvature
+    // Transform and size only — geometry is a shared MeshPool grid
+    ofNode node;
+    float width = 0;
+    float height = 0;
+    mutable MeshPool::Handle grid; // current LOD, re-acquired when it changes
+
+    // Curvature — applied in ScreenShader to a shared grid, no per-screen mesh
     float curvature = 0;       // degrees of arc (-180 to 180)
-    ofVboMesh curvedMesh;
-    int meshColumns = 32;
-    int meshRows = 2;
-    void rebuildMesh();
+    CurveAxis curveAxis = CurveAxis::Horizontal;
+    void drawGeometry(ScreenShader& shader, const CurveParams& curve, float pixelsPerUnit);
+    void drawOutline(ScreenShader& shader, const CurveParams& curve, float pixelsPerUnit);
 
-    // Polygon mask
+    // Polygon mask — rasterized once into a shared alpha texture (MaskCache)
     std::vector<glm::vec2> maskPoints; // normalized 0-1 contour
-    ofVboMesh polygonMesh;
-    void rebuildPolygonMesh();
+    mutable std::shared_ptr<MaskCache::Mask> mask;
+    mutable ofPolyline maskOutline; // contour in unit-grid space, densified so the shader bends it
+    mutable bool maskDirty = true;
 
-    // Input mapping (crop)
+    // Input mapping (crop) — applied in ScreenShader, not baked into UVs
     ofRectangle cropRect{0, 0, 1, 1};  // normalized region
 
-#ifdef TARGET_OSX
-    ofxSyphonClient client;
-    bool clientSetup = false;
-#elif defined(TARGET_WIN32)
-    ofxSpout::Receiver spoutReceiver;
-    ofTexture spoutTexture;
-    bool spoutSetup = false;
-#endif
+    std::shared_ptr<SharedSource> source; // null when disconnected
+
+    // Transform cache
+    mutable glm::mat4 worldMatrix{1.0f};
+    mutable glm::mat4 inverseWorldMatrix{1.0f};
+    mutable bool worldDirty = true;
+    mutable bool inverseDirty = true;
+    mutable glm::vec3 rotationEuler{0.0f}; // quaternion → Euler is not free either
+    mutable bool eulerDirty = true;
+    uint64_t transformGeneration = 0;
+    uint64_t shapeGeneration = 0;
+    uint64_t contentGeneration = 0;
+    SceneJournal* journal = nullptr;
+    void transformChanged();
+    void shapeChanged(SceneEvent::Type type = SceneEvent::ShapeChanged);
+    void contentChanged(SceneEvent::Type type);
 };
@@ -0,0 +1,205 @@
+#include "win_byte_fix.h"
+#include "ScreenShader.h"
+
+// --- Shader sources ---
+
+static const char* vertexSrc = R"(
+uniform mat4 modelViewProjectionMatrix;
+uniform mat4 modelViewMatrix;
+uniform vec4 cropRect;   // x, y, w, h (normalized 0-1)
+uniform float flipV;     // 1 = source texture is stored upside down
+uniform vec2 texSize;    // texture extent in sampler coordinates
+
+uniform vec2 gridSize;   // unit grid → local units (1,1 for real meshes)
+uniform int curveMode;   // 0 flat, 1 horizontal, 2 vertical, 3 spherical
+uniform float curveSign;
+uniform float curveRadius;
+uniform vec2 halfAngle;  // radians (across width, across height)
+
+in vec4 position;
+in vec2 texcoord;        // static normalized UV baked into the mesh
+
+out vec2 vTexCoord;
+out vec2 vMaskCoord;     // uncropped UV: the mask follows the screen, not the source
+out vec3 vNormal;        // eye space, for the shaded solid fill
+
+void main() {
+    vMaskCoord = texcoord;
+    vec2 uv = cropRect.xy + texcoord * cropRect.zw;
+    if (flipV > 0.5) uv.y = 1.0 - uv.y;
+    vTexCoord = uv * texSize;
+
+    vec3 p = vec3(position.xy * gridSize, position.z);
+    vec3 n = vec3(0.0, 0.0, 1.0);
+    if (curveMode == 1) {
+        float a = position.x * 2.0 * halfAngle.x;
+        p.x = curveRadius * sin(a);
+        p.z = curveSign * curveRadius * (cos(a) - cos(halfAngle.x));
+        n = vec3(curveSign * sin(a), 0.0, cos(a));
+    } else if (curveMode == 2) {
+        float a = position.y * 2.0 * halfAngle.y;
+        p.y = curveRadius * sin(a);
+        p.z = curveSign * curveRadius * (cos(a) - cos(halfAngle.y));
+        n = vec3(0.0, curveSign * sin(a), cos(a));
+    } else if (curveMode == 3) {
+        float t = position.x * 2.0 * halfAngle.x;
+        float f = position.y * 2.0 * halfAngle.y;
+        p.x = curveRadius * sin(t) * cos(f);
+        p.y = curveRadius * sin(f);
+        p.z = curveSign * curveRadius * (cos(t) * cos(f) - cos(halfAngle.x));
+        n = vec3(curveSign * sin(t) * cos(f), curveSign * sin(f), cos(t) * cos(f));
+    }
+    vNormal = transpose(inverse(mat3(modelViewMatrix))) * n;
+    gl_Position = modelViewProjectionMatrix * vec4(p, 1.0);
+}
+)";
+
+static const char* fragmentSrc = R"(
+uniform SAMPLER tex0;
+uniform vec4 globalColor;
+uniform float textured;   // 0 = solid globalColor
+uniform float overBlack;  // 1 = composite source alpha over black (View mode)
+uniform sampler2D maskTex;
+uniform float masked;     // 1 = multiply alpha by the rasterized mask
+uniform float shaded;     // 1 = light the solid fill (Designer mode screens)
+uniform vec3 lightDir;    // eye space, towards the light
+uniform vec2 lightTerms;  // ambient, diffuse
+
+in vec2 vTexCoord;
+in vec2 vMaskCoord;
+in vec3 vNormal;
+
+out vec4 outputColor;
+
+void main() {
+    vec4 c = globalColor;
+    if (shaded > 0.5) {
+        float lambert = max(dot(normalize(vNormal), lightDir), 0.0);
+        c.rgb *= min(lightTerms.x + lightTerms.y * lambert, 1.0);
+    }
+    if (textured > 0.5) {
+        c = texture(tex0, vTexCoord) * globalColor;
+        if (overBlack > 0.5) c = vec4(c.rgb * c.a, 1.0);
+    }
+    if (masked > 0.5) {
+        float m = texture(maskTex, vMaskCoord).r;
+        if (m < 0.004) discard; // keep cut-away areas out of the depth buffer
+        c.a *= m;
+    }
+    outputColor = c;
+}
+)";
+
+static void compile(ofShader& shader, const std::string& sampler) {
+    std::string header = "#version 150\n#define SAMPLER " + sampler + "\n";
+    shader.setupShaderFromSource(GL_VERTEX_SHADER, header + vertexSrc);
+    shader.setupShaderFromSource(GL_FRAGMENT_SHADER, header + fragmentSrc);
+    shader.bindDefaults(); // position/texcoord attribute locations used by ofVbo
+    shader.linkProgram();
+}
+
+// --- CurveParams ---
+
+CurveParams CurveParams::compute(float width, float height, float curvatureDeg, CurveAxis axis) {
+    CurveParams c;
+    float total = std::abs(curvatureDeg) * DEG_TO_RAD;
+    if (total <= 0.1f * DEG_TO_RAD || width <= 0 || height <= 0) return c;
+
+    c.sign = (curvatureDeg >= 0) ? 1.0f : -1.0f;
+    switch (axis) {
+        case CurveAxis::Horizontal:
+            c.mode = 1;
+            c.halfAngleH = total / 2.0f;
+            c.radius = (width / 2.0f) / sin(c.halfAngleH);
+            break;
+        case CurveAxis::Vertical:
+            c.mode = 2;
+            c.halfAngleV = total / 2.0f;
+            c.radius = (height / 2.0f) / sin(c.halfAngleV);
+            break;
+        case CurveAxis::Spherical:
+            // Curvature sets the arc across the width; the height spans
+            // whatever angle keeps its chord on the same sphere
+            c.mode = 3;
+            c.halfAngleH = total / 2.0f;
+            c.radius = (width / 2.0f) / sin(c.halfAngleH);
+            c.halfAngleV = asin(std::min(1.0f, (height / 2.0f) / c.radius));
+            break;
+    }
+    return c;
+}
+
+// --- ScreenShader ---
+
+void ScreenShader::setup() {
+    compile(shader2D, "sampler2D");
+    compile(shaderRect, "sampler2DRect");
+}
+
+void ScreenShader::begin(const ofTexture* tex, const ofRectangle& crop, bool overBlack) {
+    bool rect = tex && tex->getTextureData().textureTarget != GL_TEXTURE_2D;
+    active = rect ? &shaderRect : &shader2D;
+
+    active->begin();
+    active->setUniform4f("cropRect", crop.x, crop.y, crop.width, crop.height);
+    active->setUniform1f("overBlack", overBlack ? 1.0f : 0.0f);
+    if (tex) {
+        const ofTextureData& td = tex->getTextureData();
+        active->setUniformTexture("tex0", *tex, 0);
+        active->setUniform1f("flipV", td.bFlipTexture ? 1.0f : 0.0f);
+        // tex_t/tex_u: 1.0 for 2D textures (less for padded POT), pixel size for rectangles
+        active->setUniform2f("texSize", td.tex_t, td.tex_u);
+    }
+    active->setUniform1f("textured", tex ? 1.0f : 0.0f);
+    active->setUniform1f("shaded", tex ? 0.0f : 1.0f);
+    active->setUniform3f("lightDir", lightDir);
+    active->setUniform2f("lightTerms", lightAmbient, lightDiffuse);
+    active->setUniform1f("masked", 0.0f);
+    setGeometry(1.0f, 1.0f, CurveParams());
+}
+
+void ScreenShader::end() {
+    if (active) {
+        active->end();
+        active = nullptr;
+    }
+}
+
+void ScreenShader::setGeometry(float width, float height, const CurveParams& curve) {
+    if (!active) return;
+    active->setUniform2f("gridSize", width, height);
+    active->setUniform1i("curveMode", curve.mode);
+    active->setUniform1f("curveSign", curve.sign);
+    active->setUniform1f("curveRadius", curve.radius);
+    active->setUniform2f("halfAngle", curve.halfAngleH, curve.halfAngleV);
+}
+
+void ScreenShader::setMask(const ofTexture* mask) {
+    if (!active) return;
+    if (mask) active->setUniformTexture("maskTex", *mask, 1);
+    active->setUniform1f("masked", mask ? 1.0f : 0.0f);
+}
+
+void ScreenShader::setTextured(bool textured) {
+    if (!active) return;
+    active->setUniform1f("textured", textured ? 1.0f : 0.0f);
+    active->setUniform1f("shaded", 0.0f);
+}
+
+void ScreenShader::setLight(const glm::vec3& eyeDir, float ambient, float diffuse) {
+    lightDir = eyeDir;
+    lightAmbient = ambient;
+    lightDiffuse = diffuse;
+}
+
+int ScreenShader::segmentsFor(float radius, float arcAngle, float pixelsPerUnit) {
+    if (arcAngle <= 0 || radius <= 0) return 1;
+    if (pixelsPerUnit <= 0) return MAX_SEGMENTS; // unknown scale: full detail
+
+    // Sagitta of one segment: radius * step^2 / 8 <= 0.5 px
+    float step = sqrt(4.0f / (pixelsPerUnit * radius));
+    int needed = (int)ceil(arcAngle / step);
+    int segs = MIN_SEGMENTS;
+    while (segs < needed && segs < MAX_SEGMENTS) segs *= 2;
+    return segs;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "ofMain.h"
+
+// Axis a curved screen bends around
+enum class CurveAxis { Horizontal, Vertical, Spherical };
+
+// Arc parameters for a curved screen, derived on the CPU from width, height,
+// curvature and axis. The chord (flat width/height) is preserved: the edges
+// of the curved axis stay at +-size/2 with z = 0, the middle bulges by the
+// sagitta toward +z (positive curvature) or -z (negative).
+struct CurveParams {
+    int mode = 0;           // 0 = flat, 1 = horizontal, 2 = vertical, 3 = spherical
+    float sign = 1.0f;      // bulge direction
+    float radius = 0.0f;
+    float halfAngleH = 0.0f; // radians, across the width
+    float halfAngleV = 0.0f; // radians, across the height
+
+    static CurveParams compute(float width, float height, float curvatureDeg, CurveAxis axis);
+};
+
+// Shared shader for screens.
+// Screen meshes carry static normalized UVs (0-1, V=0 at the top edge);
+// crop rect and flip are applied per draw as uniforms. Screens draw a shared
+// unit grid (MeshPool) that the vertex shader scales to the screen size and
+// bends along an arc, so no screen owns a mesh; polygon masks are an alpha
+// texture sampled in the fragment shader.
+class ScreenShader {
+public:
+    // Compile both sampler variants (needs a GL context — call from setup)
+    void setup();
+
+    // Bind for one screen. tex == nullptr draws the current ofSetColor as a
+    // solid fill (no source), lit by setLight. overBlack composites source
+    // alpha over black in the same pass (View mode LED look).
+    void begin(const ofTexture* tex, const ofRectangle& crop, bool overBlack = false);
+    void end();
+
+    // Geometry for the next draws: unit grids are scaled to width x height
+    // and bent by curve
+    void setGeometry(float width, float height, const CurveParams& curve);
+
+    // Clip to a mask texture in the screen's UV space (nullptr = no mask)
+    void setMask(const ofTexture* mask);
+
+    // Switch the bound shader to solid, unlit color (outline passes)
+    void setTextured(bool textured);
+
+    // Directional light for solid fills, applied from the next begin():
+    // direction towards the light in eye space, ambient + diffuse * N.L
+    void setLight(const glm::vec3& eyeDir, float ambient, float diffuse);
+
+    // Grid resolution along a curved axis: segments whose chord error stays
+    // under ~half a pixel at the given on-screen scale, as a power of two
+    static int segmentsFor(float radius, float arcAngle, float pixelsPerUnit);
+    static const int MIN_SEGMENTS = 4;
+    static const int MAX_SEGMENTS = 128;
+
+private:
+    ofShader shader2D;   // GL_TEXTURE_2D sources (and solid fills)
+    ofShader shaderRect; // GL_TEXTURE_RECTANGLE sources (Syphon, ARB textures)
+    ofShader* active = nullptr;
+
+    glm::vec3 lightDir{0, 0, 1};
+    float lightAmbient = 1.0f; // unlit until setLight
+    float lightDiffuse = 0.0f;
+};
@@ -0,0 +1,131 @@
+#include "win_byte_fix.h"
+#include "ScreenStore.h"
+
+void ScreenStore::sync(const std::vector<std::unique_ptr<ScreenObject>>& screens) {
+    if (screens.size() != objects.size()) {
+        resize(screens.size());
+        listVersion++;
+    }
+
+    for (size_t i = 0; i < screens.size(); i++) {
+        ScreenObject* screen = screens[i].get();
+        if (objects[i] != screen) {
+            objects[i] = screen;
+            listVersion++;
+        } else if (revisions[i] == screen->getRevision()) {
+            continue;
+        }
+        writeSlot((int)i, *screen);
+    }
+}
+
+void ScreenStore::resize(size_t n) {
+    for (size_t i = n; i < sourceIds.size(); i++) releaseSource(sourceIds[i]);
+    objects.resize(n, nullptr);
+    revisions.resize(n, 0);
+    boundsVersion.resize(n, 0);
+    for (auto* v : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ, &centerX, &centerY, &centerZ }) {
+        v->resize(n);
+    }
+    instanceModels.resize(n);
+    crops.resize(n);
+    flags.resize(n);
+    sourceIds.resize(n, -1);
+}
+
+void ScreenStore::writeSlot(int i, ScreenObject& screen) {
+    revisions[i] = screen.getRevision();
+
+    const glm::mat4& world = screen.getWorldMatrix();
+    glm::vec3 lmin, lmax;
+    screen.getLocalBounds(lmin, lmax);
+    AABB b = AABB::transformed(world, lmin, lmax);
+    if (b != getBounds(i)) {
+        minX[i] = b.min.x; minY[i] = b.min.y; minZ[i] = b.min.z;
+        maxX[i] = b.max.x; maxY[i] = b.max.y; maxZ[i] = b.max.z;
+        boundsVersion[i] = nextBoundsVersion++;
+    }
+    centerX[i] = world[3].x;
+    centerY[i] = world[3].y;
+    centerZ[i] = world[3].z;
+
+    instanceModels[i] = world *
+        glm::scale(glm::mat4(1.0f), glm::vec3(screen.getPlaneWidth(), screen.getPlaneHeight(), 1.0f));
+    const ofRectangle& r = screen.getCropRect();
+    crops[i] = glm::vec4(r.x, r.y, r.width, r.height);
+
+    uint8_t f = 0;
+    if (screen.isFlat()) f |= FLAG_FLAT;
+    if (screen.hasMask()) f |= FLAG_MASKED;
+    if (screen.hasSource()) f |= FLAG_SOURCE;
+    flags[i] = f;
+    // Intern before releasing, so an unchanged name keeps its id
+    int sourceId = screen.hasSource() ? internSource(screen.sourceName) : -1;
+    releaseSource(sourceIds[i]);
+    sourceIds[i] = sourceId;
+}
+
+int ScreenStore::internSource(const std::string& name) {
+    auto it = sourceIdByName.find(name);
+    if (it != sourceIdByName.end()) {
+        sourceRefs[it->second]++;
+        return it->second;
+    }
+    int id;
+    if (!freeSourceIds.empty()) {
+        id = freeSourceIds.back();
+        freeSourceIds.pop_back();
+        sourceNames[id] = name;
+        sourceRefs[id] = 1;
+    } else {
+        id = (int)sourceNames.size();
+        sourceNames.push_back(name);
+        sourceRefs.push_back(1);
+    }
+    sourceIdByName[name] = id;
+    return id;
+}
+
+void ScreenStore::releaseSource(int id) {
+    if (id < 0 || --sourceRefs[id] > 0) return;
+    sourceIdByName.erase(sourceNames[id]);
+    sourceNames[id].clear();
+    freeSourceIds.push_back(id);
+}
+
+// --- Array passes ---
+
+void ScreenStore::cull(const Frustum& frustum, std::vector<int>& out) const {
+    size_t n = objects.size();
+    inside.assign(n, 1);
+
+    // One pass per plane over plain float arrays (vectorizes): test the box
+    // corner furthest along the plane normal, chosen per plane not per box
+    for (const auto& p : frustum.planes) {
+        const float* xs = (p.x >= 0 ? maxX : minX).data();
+        const float* ys = (p.y >= 0 ? maxY : minY).data();
+        const float* zs = (p.z >= 0 ? maxZ : minZ).data();
+        uint8_t* in = inside.data();
+        for (size_t i = 0; i < n; i++) {
+            in[i] &= (uint8_t)(p.x * xs[i] + p.y * ys[i] + p.z * zs[i] + p.w >= 0);
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (inside[i]) out.push_back((int)i);
+    }
+}
+
+void ScreenStore::centersInside(const glm::mat4& m, float ndcMinX, float ndcMaxX,
+                                float ndcMinY, float ndcMaxY, std::vector<int>& out) const {
+    size_t n = objects.size();
+    for (size_t i = 0; i < n; i++) {
+        float x = m[0][0] * centerX[i] + m[1][0] * centerY[i] + m[2][0] * centerZ[i] + m[3][0];
+        float y = m[0][1] * centerX[i] + m[1][1] * centerY[i] + m[2][1] * centerZ[i] + m[3][1];
+        float w = m[0][3] * centerX[i] + m[1][3] * centerY[i] + m[2][3] * centerZ[i] + m[3][3];
+        // Compare in clip space (no divide); w > 0 keeps points behind the eye out
+        if (w > 0 && x >= ndcMinX * w && x <= ndcMaxX * w && y >= ndcMinY * w && y <= ndcMaxY * w) {
+            out.push_back((int)i);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "ofMain.h"
+#include "Bounds.h"
+#include "ScreenObject.h"
+#include <vector>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Contiguous per-frame data for Scene's screens (structure of arrays).
+// ScreenObject stays the authoring object; sync() mirrors the fields that
+// per-frame passes read into flat arrays indexed like Scene::screens, and
+// rewrites a slot only when that screen's revision moved. Culling, box
+// selection and batched drawing then scan arrays instead of chasing one
+// heap object (node, strings, caches) per screen.
+class ScreenStore {
+public:
+    enum Flags : uint8_t {
+        FLAG_FLAT   = 1 << 0, // drawable by the instanced batch path
+        FLAG_MASKED = 1 << 1,
+        FLAG_SOURCE = 1 << 2, // connected to a shared source
+    };
+
+    // Bring every slot in line with the screen list
+    void sync(const std::vector<std::unique_ptr<ScreenObject>>& screens);
+
+    int size() const { return (int)objects.size(); }
+    ScreenObject* getObject(int i) const { return objects[i]; }
+
+    // Bumps whenever a slot holds a different screen (add/remove/reorder)
+    uint64_t getListVersion() const { return listVersion; }
+    // Per slot: bumps whenever that slot's world bounds were rewritten
+    uint64_t getBoundsVersion(int i) const { return boundsVersion[i]; }
+
+    AABB getBounds(int i) const {
+        AABB b;
+        b.min = glm::vec3(minX[i], minY[i], minZ[i]);
+        b.max = glm::vec3(maxX[i], maxY[i], maxZ[i]);
+        return b;
+    }
+    glm::vec3 getCenter(int i) const { return glm::vec3(centerX[i], centerY[i], centerZ[i]); }
+    uint8_t getFlags(int i) const { return flags[i]; }
+    int getSourceId(int i) const { return sourceIds[i]; }     // -1 = none
+    int getSourceIdCount() const { return (int)sourceNames.size(); }
+
+    // World matrix * scale(width, height, 1) and crop (x, y, w, h), ready
+    // for the instanced quad
+    const glm::mat4& getInstanceModel(int i) const { return instanceModels[i]; }
+    const glm::vec4& getCrop(int i) const { return crops[i]; }
+
+    // Screens whose bounds touch the frustum (conservative), in list order
+    void cull(const Frustum& frustum, std::vector<int>& out) const;
+
+    // Screens whose world center projects inside an NDC rectangle, in list order
+    void centersInside(const glm::mat4& viewProj, float ndcMinX, float ndcMaxX,
+                       float ndcMinY, float ndcMaxY, std::vector<int>& out) const;
+
+private:
+    void resize(size_t n);
+    void writeSlot(int i, ScreenObject& screen);
+    int internSource(const std::string& name);
+    void releaseSource(int id);
+
+    std::vector<ScreenObject*> objects;
+    std::vector<uint64_t> revisions;
+    std::vector<uint64_t> boundsVersion;
+    uint64_t listVersion = 0;
+    uint64_t nextBoundsVersion = 1;
+
+    // World bounds and centers, one array per component
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+    std::vector<float> centerX, centerY, centerZ;
+
+    std::vector<glm::mat4> instanceModels;
+    std::vector<glm::vec4> crops;
+    std::vector<uint8_t> flags;
+    std::vector<int> sourceIds;
+
+    // Source names interned to small ids (batches key on the id). Ids are
+    // counted per slot and recycled once unused, so the table stays as small
+    // as the set of names in use at the same time.
+    std::vector<std::string> sourceNames;
+    std::vector<int> sourceRefs;
+    std::vector<int> freeSourceIds;
+    std::unordered_map<std::string, int> sourceIdByName;
+
+    // Scratch for cull()
+    mutable std::vector<uint8_t> inside;
+};
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// SHA-256 (FIPS 180-4), for checking downloaded updates against the digest
+// published with the release. Feed data with update(), then call hex() once.
+class Sha256 {
+public:
+    Sha256();
+
+    void update(const void* data, size_t size);
+    std::string hex(); // lowercase; finishes the hash
+
+    // Digest of a whole file, read in chunks; false if it cannot be read
+    static bool fileHex(const std::string& path, std::string& outHex);
+
+private:
+    void block(const uint8_t* p);
+
+    uint32_t state[8];
+    uint8_t  buffer[64];
+    size_t   buffered = 0;
+    uint64_t length = 0; // bytes
+};
@@ -0,0 +1,94 @@
+#include "win_byte_fix.h"
+#include "SourceRegistry.h"
+
+// --- SharedSource ---
+
+SharedSource::~SharedSource() {
+#ifdef TARGET_WIN32
+    receiver.release();
+#endif
+    ofLogNotice("SourceRegistry") << "Released receiver: " << name;
+}
+
+ofTexture* SharedSource::lock() {
+    lastLockFrame = ofGetFrameNum();
+#ifdef TARGET_OSX
+    if (client.lockTexture()) {
+        return &client.getTexture();
+    }
+#elif defined(TARGET_WIN32)
+    if (texture.isAllocated()) {
+        return &texture;
+    }
+#endif
+    return nullptr;
+}
+
+void SharedSource::unlock() {
+#ifdef TARGET_OSX
+    client.unlockTexture();
+#endif
+}
+
+// --- SourceRegistry ---
+
+#ifdef TARGET_OSX
+std::shared_ptr<SharedSource> SourceRegistry::acquire(const ofxSyphonServerDescription& desc) {
+    std::string key = desc.appName + " - " + desc.serverName;
+    if (auto existing = sources[key].lock()) {
+        return existing;
+    }
+
+    auto src = std::make_shared<SharedSource>();
+    src->name = key;
+    src->client.setup();
+    src->client.set(desc);
+    sources[key] = src;
+    ofLogNotice("SourceRegistry") << "Opened receiver: " << key;
+    return src;
+}
+#elif defined(TARGET_WIN32)
+std::shared_ptr<SharedSource> SourceRegistry::acquire(const std::string& senderName) {
+    if (auto existing = sources[senderName].lock()) {
+        return existing;
+    }
+
+    auto src = std::make_shared<SharedSource>();
+    src->name = senderName;
+    if (!src->receiver.init(senderName)) {
+        ofLogError("SourceRegistry") << "Failed to init Spout receiver for: " << senderName;
+        sources.erase(senderName);
+        return nullptr;
+    }
+    sources[senderName] = src;
+    ofLogNotice("SourceRegistry") << "Opened Spout receiver: " << senderName;
+    return src;
+}
+#endif
+
+void SourceRegistry::update() {
+    for (auto it = sources.begin(); it != sources.end();) {
+        auto src = it->second.lock();
+        if (!src) {
+            it = sources.erase(it);
+            continue;
+        }
+#ifdef TARGET_WIN32
+        // One copy per sender per frame, however many screens show it, and
+        // none for senders only used by culled screens (first frame always)
+        bool inView = src->lastLockFrame + 1 >= ofGetFrameNum();
+        if (inView || !src->texture.isAllocated()) {
+            src->receiver.receive(src->texture);
+        }
+#endif
+        ++it;
+    }
+}
+
+int SourceRegistry::getReceiverCount() const {
+    int count = 0;
+    for (auto& kv : sources) {
+        if (!kv.second.expired()) count++;
+    }
+    return count;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "ofMain.h"
+#include <string>
+#include <map>
+#include <memory>
+
+#ifdef TARGET_OSX
+#include "ofxSyphon.h"
+#elif defined(TARGET_WIN32)
+#include "ofxSpout.h"
+#endif
+
+// One receiver for one Syphon server / Spout sender, shared by every screen
+// showing it. Screens hold a std::shared_ptr; the receiver is released when
+// the last screen lets go.
+class SharedSource {
+public:
+    ~SharedSource();
+
+    const std::string& getName() const { return name; }
+
+    // Borrow the current frame (nullptr if nothing received yet).
+    // Every non-null result must be released with unlock().
+    ofTexture* lock();
+    void unlock();
+
+private:
+    friend class SourceRegistry;
+    std::string name;
+    uint64_t lastLockFrame = 0; // frame a visible screen last drew this source
+
+#ifdef TARGET_OSX
+    ofxSyphonClient client;
+#elif defined(TARGET_WIN32)
+    ofxSpout::Receiver receiver;
+    ofTexture texture;
+#endif
+};
+
+// Ref-counted registry of shared receivers, keyed by source name
+// ("App - Server" on macOS, sender name on Windows). Owned by Scene.
+class SourceRegistry {
+public:
+#ifdef TARGET_OSX
+    std::shared_ptr<SharedSource> acquire(const ofxSyphonServerDescription& desc);
+#elif defined(TARGET_WIN32)
+    std::shared_ptr<SharedSource> acquire(const std::string& senderName);
+#endif
+
+    // Receive each live sender once per frame (skipping ones no visible
+    // screen drew last frame) and drop released entries
+    void update();
+
+    // Number of receivers currently open
+    int getReceiverCount() const;
+
+private:
+    std::map<std::string, std::weak_ptr<SharedSource>> sources;
+};
@@ -1,74 +1,190 @@
 #include "win_byte_fix.h"
 #include "UndoManager.h"
 #include "Scene.h"
+#include <unordered_set>
 
-SceneSnapshot UndoManager::captureState(Scene& scene) {
-    SceneSnapshot snap;
-    for (auto& screen : scene.screens) {
-        SceneSnapshot::ScreenData sd;
-        sd.json = screen->toJson();
-        snap.screens.push_back(sd);
+bool UndoManager::checkpoint(Scene& scene) {
+    if (!hasBaseline) {
+        // First checkpoint after clear(): remember the scene, nothing to record
+        shadow.clear();
+        shadowOrder.clear();
+        for (auto& screen : scene.screens) {
+            shadow[screen->uid] = { screen->toJson(), screen->getRevision() };
+            shadowOrder.push_back(screen->uid);
+        }
+        shadowSelection = scene.getSelectedIndicesSorted();
+        shadowPrimary = scene.getPrimarySelected();
+        journalSequence = scene.getJournal().getSequence();
+        hasBaseline = true;
+        return false;
+    }
+
+    // Which screens were edited, and whether the list itself changed
+    std::vector<SceneEvent> events;
+    bool fullScan = !scene.getJournal().eventsSince(journalSequence, events);
+    journalSequence = scene.getJournal().getSequence();
+    std::unordered_set<uint64_t> touched;
+    for (auto& e : events) {
+        if (e.type == SceneEvent::ScreenAdded || e.type == SceneEvent::ScreenRemoved) fullScan = true;
+        else if (e.type != SceneEvent::SelectionChanged) touched.insert(e.uid);
     }
-    snap.selectedIndices = scene.selectedIndices;
-    snap.primarySelected = scene.primarySelected;
-    return snap;
-}
 
-void UndoManager::restoreState(Scene& scene, const SceneSnapshot& snapshot) {
-    // Disconnect all existing screens
+    UndoDelta delta;
+    std::vector<uint64_t> order;
+    if (!fullScan) order = shadowOrder;
+    else order.reserve(scene.screens.size());
+
+    // Added or modified: only screens whose revision moved are serialized
     for (auto& screen : scene.screens) {
-        screen->disconnectSource();
+        if (!fullScan) {
+            if (touched.empty()) break;
+            if (!touched.erase(screen->uid)) continue;
+        } else {
+            order.push_back(screen->uid);
+        }
+        auto it = shadow.find(screen->uid);
+        if (it == shadow.end()) {
+            ofJson j = screen->toJson();
+            delta.changes.push_back({ screen->uid, ofJson(), j });
+            shadow[screen->uid] = { j, screen->getRevision() };
+        } else if (it->second.revision != screen->getRevision()) {
+            ofJson j = screen->toJson();
+            if (j != it->second.json) {
+                delta.changes.push_back({ screen->uid, it->second.json, j });
+                it->second.json = j;
+            }
+            it->second.revision = screen->getRevision();
+        }
     }
-    scene.screens.clear();
 
-    // Rebuild screens from snapshot
-    for (auto& sd : snapshot.screens) {
-        auto screen = std::make_unique<ScreenObject>();
-        screen->fromJson(sd.json);
-        scene.screens.push_back(std::move(screen));
+    // Removed
+    if (order != shadowOrder) {
+        std::unordered_set<uint64_t> alive(order.begin(), order.end());
+        for (uint64_t uid : shadowOrder) {
+            if (alive.count(uid)) continue;
+            auto it = shadow.find(uid);
+            delta.changes.push_back({ uid, it->second.json, ofJson() });
+            shadow.erase(it);
+        }
+        delta.orderChanged = true;
+        delta.orderBefore = shadowOrder;
+        delta.orderAfter = order;
+        shadowOrder = order;
     }
 
-    // Restore selection
-    scene.selectedIndices = snapshot.selectedIndices;
-    scene.primarySelected = snapshot.primarySelected;
+    delta.selectionBefore = shadowSelection;
+    delta.primaryBefore = shadowPrimary;
+    delta.selectionAfter = scene.getSelectedIndicesSorted();
+    delta.primaryAfter = scene.getPrimarySelected();
+    shadowSelection = delta.selectionAfter;
+    shadowPrimary = delta.primaryAfter;
 
-    // Reconnect sources by name
-    scene.reconnectSources();
-}
-
-void UndoManager::pushState(Scene& scene) {
-    SceneSnapshot snap = captureState(scene);
+    if (delta.changes.empty() && !delta.orderChanged) return false;
 
     // Truncate any redo history
-    if (currentIndex + 1 < (int)history.size()) {
-        history.erase(history.begin() + currentIndex + 1, history.end());
-    }
-
-    history.push_back(snap);
-    currentIndex = (int)history.size() - 1;
+    history.resize(currentIndex);
+    history.push_back(std::move(delta));
+    currentIndex = (int)history.size();
 
     // Cap at MAX_HISTORY
     if ((int)history.size() > MAX_HISTORY) {
         history.erase(history.begin());
         currentIndex--;
     }
+    return true;
+}
+
+void UndoManager::applyDelta(Scene& scene, const UndoDelta& delta, bool forward) {
+    // Reconnects resolve once per source at commit, after the new order is in
+    scene.beginBatch();
+
+    // Current screens by uid; only the changed ones are touched
+    std::unordered_map<uint64_t, int> indexOf;
+    for (int i = 0; i < (int)scene.screens.size(); i++) {
+        indexOf[scene.screens[i]->uid] = i;
+    }
+
+    std::unordered_map<uint64_t, std::unique_ptr<ScreenObject>> created;
+
+    for (auto& change : delta.changes) {
+        const ofJson& target = forward ? change.after : change.before;
+        auto it = indexOf.find(change.uid);
+
+        if (target.is_null()) {
+            // Left out of the new order below; dropping it releases its receiver
+            shadow.erase(change.uid);
+            continue;
+        }
+
+        ScreenObject* screen;
+        if (it != indexOf.end()) {
+            screen = scene.screens[it->second].get();
+            std::string oldSource = screen->sourceName;
+            screen->fromJson(target);
+            // Keep the live receiver unless the source actually changed
+            if (screen->sourceName != oldSource) {
+                std::string wanted = screen->sourceName;
+                screen->disconnectSource();
+                screen->sourceName = wanted;
+                scene.reconnectSource(*screen);
+            }
+        } else {
+            auto fresh = std::make_unique<ScreenObject>();
+            fresh->uid = change.uid;
+            fresh->fromJson(target);
+            scene.reconnectSource(*fresh);
+            screen = fresh.get();
+            created[change.uid] = std::move(fresh);
+        }
+        shadow[change.uid] = { target, screen->getRevision() };
+    }
+
+    if (delta.orderChanged) {
+        // Removed screens are absent from the order, so Scene drops them
+        const auto& order = forward ? delta.orderAfter : delta.orderBefore;
+        scene.setScreenOrder(order, std::move(created));
+        shadowOrder = order;
+    }
+
+    // Restore selection (Scene ignores indices past the end)
+    const auto& sel = forward ? delta.selectionAfter : delta.selectionBefore;
+    int primary = forward ? delta.primaryAfter : delta.primaryBefore;
+    scene.setSelection(sel, primary);
+    shadowSelection = scene.getSelectedIndicesSorted();
+    shadowPrimary = scene.getPrimarySelected();
+    scene.commit();
+    // The shadow already holds what this delta applied
+    journalSequence = scene.getJournal().getSequence();
+}
+
+void UndoManager::pushState(Scene& scene) {
+    checkpoint(scene);
 }
 
 bool UndoManager::undo(Scene& scene) {
+    // Capture edits made since the last checkpoint so they can be undone too
+    checkpoint(scene);
     if (!canUndo()) return false;
     currentIndex--;
-    restoreState(scene, history[currentIndex]);
+    applyDelta(scene, history[currentIndex], false);
     return true;
 }
 
 bool UndoManager::redo(Scene& scene) {
+    checkpoint(scene); // a pending edit discards the redo branch
     if (!canRedo()) return false;
+    applyDelta(scene, history[currentIndex], true);
     currentIndex++;
-    restoreState(scene, history[currentIndex]);
     return true;
 }
 
 void UndoManager::clear() {
     history.clear();
-    currentIndex = -1;
+    currentIndex = 0;
+    shadow.clear();
+    shadowOrder.clear();
+    shadowSelection.clear();
+    shadowPrimary = -1;
+    hasBaseline = false;
+    journalSequence = 0;
 }
@@ -2,19 +2,34 @@
 #include "ofMain.h"
 #include "ScreenObject.h"
 #include <vector>
-#include <set>
+#include <unordered_map>
 
 class Scene;
 
-struct SceneSnapshot {
-    struct ScreenData {
-        ofJson json;           // full screen state via toJson()
+// One undoable step: only the screens that changed, before and after
+struct UndoDelta {
+    struct ScreenChange {
+        uint64_t uid;
+        ofJson before;         // null = screen was added by this step
+        ofJson after;          // null = screen was removed by this step
     };
-    std::vector<ScreenData> screens;
-    std::set<int> selectedIndices;
-    int primarySelected = -1;
+    std::vector<ScreenChange> changes;
+
+    // Screen order by uid, only recorded when screens were added/removed
+    bool orderChanged = false;
+    std::vector<uint64_t> orderBefore;
+    std::vector<uint64_t> orderAfter;
+
+    std::vector<int> selectionBefore, selectionAfter; // sorted indices
+    int primaryBefore = -1, primaryAfter = -1;
 };
 
+// Delta-based undo. pushState() is a checkpoint: it reads the scene journal
+// since the last checkpoint and compares only the screens it names (all of
+// them when screens were added/removed or the journal no longer reaches
+// back), recording only what changed.
+// Undo/redo apply a delta in place via fromJson, so untouched screens (and
+// their source receivers) are left alone.
 class UndoManager {
 public:
     void pushState(Scene& scene);
@@ -22,16 +37,29 @@ public:
     bool redo(Scene& scene);
 
     bool canUndo() const { return currentIndex > 0; }
-    bool canRedo() const { return currentIndex < (int)history.size() - 1; }
+    bool canRedo() const { return currentIndex < (int)history.size(); }
 
     void clear();
 
 private:
     static const int MAX_HISTORY = 50;
 
-    SceneSnapshot captureState(Scene& scene);
-    void restoreState(Scene& scene, const SceneSnapshot& snapshot);
+    // Last checkpointed state of every screen, keyed by uid
+    struct Shadow {
+        ofJson json;
+        uint64_t revision = 0;
+    };
+    std::unordered_map<uint64_t, Shadow> shadow;
+    std::vector<uint64_t> shadowOrder;
+    std::vector<int> shadowSelection;
+    int shadowPrimary = -1;
+    bool hasBaseline = false;
+    uint64_t journalSequence = 0; // scene journal position of the shadow
+
+    // Record changes since the last checkpoint (false if nothing changed)
+    bool checkpoint(Scene& scene);
+    void applyDelta(Scene& scene, const UndoDelta& delta, bool forward);
 
-    std::vector<SceneSnapshot> history;
-    int currentIndex = -1;
+    std::vector<UndoDelta> history;
+    int currentIndex = 0;  // number of applied deltas
 };
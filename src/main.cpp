@@ -2,6 +2,8 @@
 #include "ofMain.h"
 #include "ofApp.h"
 #include "AppVersion.h"
+#include "HttpClient.h"
+#include "ProjectFile.h"
 
 // Force dedicated GPU on laptops with hybrid graphics (NVIDIA Optimus / AMD Switchable)
 #ifdef TARGET_WIN32
@@ -11,7 +13,28 @@ extern "C" {
 }
 #endif
 
-int main() {
+// Command-line converter, no window:
+//   VirtualStage --convert <in> <out>
+// Input format is detected; output is binary for *.vstage, JSON otherwise.
+static int convertProject(const std::string& inPath, const std::string& outPath) {
+    ofJson root;
+    if (!ProjectFile::load(inPath, root)) return 1;
+    if (!ProjectFile::save(outPath, root, ProjectFile::formatForPath(outPath))) return 1;
+    ofLogNotice("main") << "Converted " << inPath << " -> " << outPath;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && std::string(argv[1]) == "--convert") {
+        if (argc < 4) {
+            ofLogError("main") << "Usage: " << argv[0] << " --convert <in> <out>";
+            return 2;
+        }
+        return convertProject(argv[2], argv[3]);
+    }
+
+    HttpClient::init(); // before any worker thread can make a request
+
     ofGLFWWindowSettings settings;
     settings.setSize(1280, 720);
     settings.title = "VirtualStage v" APP_VERSION;
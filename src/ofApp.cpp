@@ -1,16 +1,18 @@
 #include "win_byte_fix.h"
 #include "ofApp.h"
+#include "ProjectFile.h"
+#include "MeshPool.h"
+#include "HttpClient.h"
+#include "Sha256.h"
 #include <GLFW/glfw3.h>
 // GLFW 3.3 (oF 0.12.0) doesn't have GLFW_RESIZE_ALL_CURSOR; define fallback
 #ifndef GLFW_RESIZE_ALL_CURSOR
 #define GLFW_RESIZE_ALL_CURSOR 0x00036009
 #endif
 #include "ofXml.h"
-#include <thread>
 #ifdef TARGET_OSX
 #include <unistd.h>
 #endif
-#include <mutex>
 
 void ofApp::setup() {
     ofSetEscapeQuitsApp(false);
@@ -27,6 +29,18 @@ void ofApp::setup() {
     scene.setup();
     scene.addScreen("Screen 1");
     scene.onServerListChanged = [this]() { refreshServerList(); };
+    refreshServerList();
+    // Re-point the panel when screens come or go, the selection moves or a
+    // source changes — on the next update, outside any panel listener
+    scene.getJournal().subscribe([this](const std::vector<SceneEvent>& events) {
+        for (auto& e : events) {
+            if (e.type == SceneEvent::ScreenAdded || e.type == SceneEvent::ScreenRemoved ||
+                e.type == SceneEvent::SelectionChanged || e.type == SceneEvent::SourceChanged) {
+                screensChanged = true;
+                return;
+            }
+        }
+    });
 
     // Properties panel (right side)
     propertiesPanel.setup(ofGetWidth() - 240, 10);
@@ -45,6 +59,17 @@ void ofApp::setup() {
     // Push initial undo state
     undoManager.pushState(scene);
 
+    // ── Background jobs ─────────────────────────────────────────────────────
+    // One request per kind at a time; a newer save, list, load or
+    // preferences upload replaces the one still waiting or in flight
+    executor.setLimit("auth", 1);
+    executor.setLimit("update", 1);
+    executor.setLimit("prefs-save", 1, true);
+    executor.setLimit("cloud-save", 1, true);
+    executor.setLimit("cloud-list", 1, true);
+    executor.setLimit("cloud-load", 1, true);
+    executor.setLimit("cloud-prefetch", 1, true);
+
     // ── Auth setup ──────────────────────────────────────────────────────────
     // Wire up the modal submit callback before checking session
     authModal.onSubmit = [this](AuthModal::Tab tab, const std::string& email,
@@ -54,22 +79,15 @@ void ofApp::setup() {
 
     authManager.loadSession();
     if (authManager.isAuthenticated()) {
-        // Already logged in — refresh token in background (silent fail = offline OK)
-        std::thread([this]() {
+        // Already logged in — refresh token in background (silent fail = offline OK),
+        // then load cloud preferences with the fresh token
+        executor.submit("auth", [this](const Executor::CancelToken&) {
             std::string err;
-            authManager.refreshToken(err); // ignore error: offline mode is fine
-        }).detach();
-        // Load cloud preferences in background
-        std::thread([this]() {
-            std::string err, cloudData;
-            if (cloudStorage.loadPreferences(authManager.getSession(), cloudData, err)) {
-                if (!cloudData.empty()) {
-                    preferences.fromJsonString(cloudData);
-                    preferences.saveLocal();
-                    prefsNeedRefresh.store(true);
-                }
-            }
-        }).detach();
+            return authManager.refreshToken(err); // ignore error: offline mode is fine
+        }, [this](const bool&) {
+            fetchCloudPreferences();
+            prefetchCloudProjects();
+        });
     } else {
         authModal.show();
         cam.disableMouseInput(); // Block camera while auth modal is up
@@ -78,6 +96,7 @@ void ofApp::setup() {
     // ── Preferences setup ────────────────────────────────────────────────────
     preferences.loadLocal();
     propertiesPanel.setPreferences(&preferences);
+    propertiesPanel.setScene(&scene);
     propertiesPanel.refreshUnitLabels();
 
     settingsModal.onPreferenceChanged = [this]() {
@@ -85,18 +104,34 @@ void ofApp::setup() {
         // Sync to cloud in background
         if (authManager.isAuthenticated()) {
             std::string jsonStr = preferences.toJsonString();
-            std::thread([this, jsonStr]() {
+            executor.submit("prefs-save", [this, jsonStr](const Executor::CancelToken&) {
                 std::string err;
-                cloudStorage.savePreferences(authManager.getSession(), jsonStr, err);
-            }).detach();
+                return cloudStorage.savePreferences(authManager.getSession(), jsonStr, err);
+            });
         }
     };
 }
 
+void ofApp::fetchCloudPreferences() {
+    executor.submit("auth", [this](const Executor::CancelToken&) {
+        std::string err, cloudData;
+        if (!cloudStorage.loadPreferences(authManager.getSession(), cloudData, err)) cloudData.clear();
+        return cloudData;
+    }, [this](const std::string& cloudData) {
+        if (cloudData.empty()) return;
+        preferences.fromJsonString(cloudData);
+        preferences.saveLocal();
+        propertiesPanel.refreshUnitLabels();
+    });
+}
+
 void ofApp::update() {
-    scene.update();
-    // Refresh server list periodically
-    servers = scene.getAvailableServers();
+    // Finished background jobs apply their results here, on the main thread
+    executor.drainCompletions();
+    AutosaveWriter::Result autosaved;
+    while (autosaveWriter.pollResult(autosaved)) onAutosaveDone(autosaved.tag, autosaved.ok);
+
+    scene.update(); // server list changes arrive through onServerListChanged
 
     // Update background from ambient light slider (0-100 → 0-60)
     bgBrightness = (int)(propertiesPanel.getAmbientLight() * 0.6f);
@@ -119,9 +154,10 @@ void ofApp::update() {
         }
     }
 
-    // Refresh UI if preferences were updated from cloud
-    if (prefsNeedRefresh.exchange(false)) {
-        propertiesPanel.refreshUnitLabels();
+    // Screens changed through Scene: refresh the panel once the edit settles
+    if (screensChanged && !propsDirty) {
+        screensChanged = false;
+        updatePropertiesForSelection();
     }
 
     // Autosave — works with both local and cloud projects
@@ -132,75 +168,38 @@ void ofApp::update() {
             doAutosave();
         }
     }
+}
 
-    // ── Auth result (written by background thread) ──────────────────────────
-    {
-        std::lock_guard<std::mutex> lock(authResultMutex);
-        if (pendingAuthResult.done) {
-            pendingAuthResult.done = false;
-            if (pendingAuthResult.success) {
-                if (pendingAuthResult.needConfirm) {
-                    authModal.setLoading(false);
-                    authModal.setSuccess("Account created! Please check your email to confirm, then sign in.");
-                } else {
-                    authModal.hide();
-                    cam.enableMouseInput(); // Re-enable camera after successful auth
-                    // Load cloud preferences after first login
-                    std::thread([this]() {
-                        std::string err, cloudData;
-                        if (cloudStorage.loadPreferences(authManager.getSession(), cloudData, err)) {
-                            if (!cloudData.empty()) {
-                                preferences.fromJsonString(cloudData);
-                                preferences.saveLocal();
-                                prefsNeedRefresh.store(true);
-                            }
-                        }
-                    }).detach();
-                }
-            } else {
-                authModal.setError(pendingAuthResult.error);
-            }
-        }
+void ofApp::applyCloudProject(const CloudProjectResult& result) {
+    if (!result.success) {
+        cloudLoadState = CloudLoadState::Error;
+        cloudLoadError = result.error;
+        return;
     }
-
-    // ── Cloud project load result ────────────────────────────────────────────
-    {
-        std::lock_guard<std::mutex> lock(cloudProjectResultMutex);
-        if (pendingCloudProject.done) {
-            pendingCloudProject.done = false;
-            if (pendingCloudProject.success) {
-                cloudLoadState = CloudLoadState::Hidden;
-                // Write to temp file and open as project
-                std::string tmpPath = ofFilePath::getUserHomeDir() + "/.virtualstage/cloud_load_tmp.json";
-                ofSavePrettyJson(tmpPath, pendingCloudProject.data);
-                ofJson camJson;
-                if (scene.loadProject(tmpPath, &camJson)) {
-                    currentProjectPath = "";
-                    currentCloudProjectName = pendingCloudProject.name;
-                    autosaveEnabled = true;
-                    autosaveTimer = 0;
-                    if (!camJson.is_null()) {
-                        try {
-                            auto pos = camJson["position"];
-                            auto tgt = camJson["target"];
-                            cam.setPosition(glm::vec3(pos[0], pos[1], pos[2]));
-                            cam.setTarget(glm::vec3(tgt[0], tgt[1], tgt[2]));
-                            cam.setDistance(camJson.value("distance", 800.0f));
-                        } catch (...) {}
-                    }
-                    undoManager.clear();
-                    pushUndo();
-                    propertiesPanel.setTarget(nullptr);
-                    scene.clearSelection();
-                }
-                ofFile::removeFile(tmpPath);
-            } else {
-                cloudLoadState = CloudLoadState::Error;
-                cloudLoadError = pendingCloudProject.error;
-            }
+    cloudLoadState = CloudLoadState::Hidden;
+    ofJson camJson;
+    if (scene.fromJson(result.data, &camJson)) {
+        currentProjectPath = "";
+        currentCloudProjectName = result.name;
+        currentCloudProjectId = result.id;
+        autosaveEnabled = true;
+        autosaveTimer = 0;
+        if (!camJson.is_null()) {
+            try {
+                auto pos = camJson["position"];
+                auto tgt = camJson["target"];
+                cam.setPosition(glm::vec3(pos[0], pos[1], pos[2]));
+                cam.setTarget(glm::vec3(tgt[0], tgt[1], tgt[2]));
+                cam.setDistance(camJson.value("distance", 800.0f));
+            } catch (...) {}
         }
+        undoManager.clear();
+        pushUndo();
+        propertiesPanel.setTarget(nullptr);
+        scene.clearSelection();
+        cloudConflict = false;
+        lastAutosaveKey = autosaveKey(); // matches the server until edited
     }
-
 }
 
 void ofApp::draw() {
@@ -397,13 +396,14 @@ void ofApp::drawServerList() {
     curY += 28;
 
     // --- Server rows ---
+    std::vector<int> selection = scene.getSelectedIndicesSorted();
     for (size_t i = 0; i < servers.size(); i++) {
         float rowTop = curY;
         float rowBot = curY + rowH;
 
         // Check if assigned to any selected screen
         bool assigned = false;
-        for (int si : scene.selectedIndices) {
+        for (int si : selection) {
             auto* sel = scene.getScreen(si);
             if (sel && sel->sourceIndex == (int)i) { assigned = true; break; }
         }
@@ -598,9 +598,23 @@ void ofApp::drawStatusBar() {
 
         nextX += fpsStr.length() * 8 + 15;
         ofSetColor(150);
-        std::string srvStr = "Servers: " + ofToString(scene.getServerCount());
+        std::string srvStr = "Servers: " + ofToString(scene.getServerCount()) +
+                             "  Receivers: " + ofToString(scene.getReceiverCount());
         ofDrawBitmapString(srvStr, nextX, barY + 20);
 
+        nextX += srvStr.length() * 8 + 15;
+        std::string drawStr = "Draws: " + ofToString(scene.getRenderStats().drawCalls) +
+                              "  Drawn: " + ofToString(scene.getDrawnCount()) +
+                              "  Culled: " + ofToString(scene.getCulledCount());
+        ofDrawBitmapString(drawStr, nextX, barY + 20);
+
+        nextX += drawStr.length() * 8 + 15;
+        MeshPool::Stats pool = MeshPool::get().getStats();
+        std::string meshStr = "Meshes: " + ofToString(pool.meshes) +
+                              " (" + ofToString(pool.gpuBytes / 1024) + " KB, " +
+                              ofToString((int)(pool.hitRate() * 100)) + "% hit)";
+        ofDrawBitmapString(meshStr, nextX, barY + 20);
+
         ofSetColor(100);
         std::string hint;
         if (linkState == LinkState::Confirm) {
@@ -609,6 +623,9 @@ void ofApp::drawStatusBar() {
         } else if (linkState == LinkState::ChooseRect) {
             ofSetColor(255, 200, 0);
             hint = "Use rects from Resolume:  I:Input  O:Output  Esc:Cancel";
+        } else if (cloudConflict) {
+            ofSetColor(255, 200, 0);
+            hint = "Newer version on the server - cloud autosave paused. Save to Cloud to overwrite it";
         } else {
             if (selectMode) {
                 ofSetColor(0, 200, 255);
@@ -948,6 +965,7 @@ bool ofApp::handleMenuClick(int x, int y) {
                                     "Enter a name to save to Cloud (free)\nor cancel for local save:", "");
                                 if (!cloudName.empty()) {
                                     currentCloudProjectName = cloudName;
+                                    currentCloudProjectId = "";
                                     saveToCloud();
                                 } else {
                                     saveProject(false);
@@ -1225,25 +1243,7 @@ bool ofApp::handleContextMenuClick(int x, int y) {
                             pos.x += 50;
                             pos.y -= 50;
                             dup->setPosition(pos);
-                            // Reconnect source if any
-                            if (!dup->sourceName.empty()) {
-                                scene.screens.push_back(std::move(dup));
-                                int newIdx = (int)scene.screens.size() - 1;
-                                // Try to reconnect by finding source index
-                                auto srvs = scene.getAvailableServers();
-                                for (int si = 0; si < (int)srvs.size(); si++) {
-                                    if (srvs[si].displayName() == scene.screens[newIdx]->sourceName
-                                        || srvs[si].serverName == scene.screens[newIdx]->sourceName) {
-                                        scene.assignSourceToScreen(newIdx, si);
-                                        break;
-                                    }
-                                }
-                                scene.selectOnly(newIdx);
-                            } else {
-                                scene.screens.push_back(std::move(dup));
-                                int newIdx = (int)scene.screens.size() - 1;
-                                scene.selectOnly(newIdx);
-                            }
+                            scene.selectOnly(scene.adoptScreen(std::move(dup)));
                             updatePropertiesForSelection();
                         }
                         break;
@@ -1280,15 +1280,15 @@ bool ofApp::handleContextMenuClick(int x, int y) {
 void ofApp::newProject() {
     pushUndo();
     // Clear all screens and reset state
-    while (scene.getScreenCount() > 0) {
-        scene.removeScreen(0);
-    }
+    scene.clearScreens();
     scene.clearSelection();
     propertiesPanel.setTarget(nullptr);
     currentProjectPath = "";
     currentCloudProjectName = "";
+    currentCloudProjectId = "";
     autosaveEnabled = false;
     autosaveTimer = 0;
+    cloudConflict = false;
 
     // Add a default screen
     scene.addScreen("Screen 1");
@@ -1320,59 +1320,67 @@ void ofApp::saveProject(bool saveAs) {
         auto result = ofSystemSaveDialog(getDefaultProjectsDir() + "/project.json", "Save VirtualStage Project");
         if (!result.bSuccess) return;
         path = result.filePath;
-        // Ensure .json extension
-        if (path.size() < 5 || path.substr(path.size() - 5) != ".json") {
+        // Ensure .json extension (or keep .vstage for the binary format)
+        if ((path.size() < 5 || path.substr(path.size() - 5) != ".json") &&
+            ProjectFile::formatForPath(path) != ProjectFile::Format::Binary) {
             path += ".json";
         }
     }
 
-    // Build camera state
-    ofJson camJson;
-    auto camPos = cam.getPosition();
-    auto camTarget = cam.getTarget().getPosition();
-    camJson["position"] = {camPos.x, camPos.y, camPos.z};
-    camJson["target"] = {camTarget.x, camTarget.y, camTarget.z};
-    camJson["distance"] = cam.getDistance();
-
-    if (scene.saveProject(path, camJson)) {
+    // Through the autosave writer, so the two never race on the same file
+    if (autosaveWriter.save(ofToDataPath(path), scene.toJson(getCameraJson()))) {
         currentProjectPath = path;
+        lastAutosaveKey = autosaveKey(); // on disk now
         ofLogNotice("ofApp") << "Project saved: " << path;
     } else {
         ofLogError("ofApp") << "Failed to save project: " << path;
     }
 }
 
+ofJson ofApp::getCameraJson() const {
+    ofJson camJson;
+    auto camPos = cam.getPosition();
+    auto camTgt = cam.getTarget().getPosition();
+    camJson["position"] = {camPos.x, camPos.y, camPos.z};
+    camJson["target"]   = {camTgt.x, camTgt.y, camTgt.z};
+    camJson["distance"] = cam.getDistance();
+    return camJson;
+}
+
+std::string ofApp::autosaveKey() const {
+    std::string target = currentCloudProjectName.empty() ? currentProjectPath : "cloud:" + currentCloudProjectName;
+    return target + "|" + ofToString(scene.getJournal().getContentSequence()) + "|" + getCameraJson().dump();
+}
+
 void ofApp::doAutosave() {
+    // Never upload over a server copy that has not been checked, or that
+    // turned out newer than what was opened
+    if (!currentCloudProjectName.empty() && (cloudRevalidating || cloudConflict)) return;
+
+    // Nothing changed since the last save (or load) of the same target, or
+    // this very state is still being saved → skip. The key is recorded only
+    // once the save succeeds, so a failed one is retried on the next tick.
+    std::string key = autosaveKey();
+    if (key == lastAutosaveKey || key == pendingAutosaveKey) return;
+
+    ofJson camJson = getCameraJson();
     if (!currentCloudProjectName.empty()) {
-        // Cloud autosave — serialize and upload silently
-        ofJson camJson;
-        auto camPos = cam.getPosition();
-        auto camTgt = cam.getTarget().getPosition();
-        camJson["position"] = {camPos.x, camPos.y, camPos.z};
-        camJson["target"]   = {camTgt.x, camTgt.y, camTgt.z};
-        camJson["distance"] = cam.getDistance();
-
-        std::string tmpPath = ofFilePath::getUserHomeDir() + "/.virtualstage/autosave_tmp.json";
-        if (scene.saveProject(tmpPath, camJson)) {
-            ofBuffer buf = ofBufferFromFile(tmpPath);
-            ofFile::removeFile(tmpPath);
-            if (buf.size() > 0) {
-                try {
-                    ofJson data = ofJson::parse(buf.getText());
-                    std::string name = currentCloudProjectName;
-                    std::thread([this, data, name]() {
-                        std::string err;
-                        cloudStorage.saveProject(authManager.getSession(), data, name, err);
-                    }).detach();
-                } catch (...) {}
-            }
-        }
+        // Cloud autosave — serialize in memory and upload silently; a newer
+        // upload supersedes one still waiting or in flight
+        pendingAutosaveKey = key;
+        uploadToCloud(scene.toJson(camJson), currentCloudProjectName, key);
     } else if (!currentProjectPath.empty()) {
-        // Local autosave
-        saveProject(false);
+        // Local autosave — build the JSON here, format and write on the worker
+        pendingAutosaveKey = key;
+        autosaveWriter.submit(ofToDataPath(currentProjectPath), scene.toJson(camJson), key);
     }
 }
 
+void ofApp::onAutosaveDone(const std::string& key, bool ok) {
+    if (key == pendingAutosaveKey) pendingAutosaveKey.clear();
+    if (ok) lastAutosaveKey = key;
+}
+
 void ofApp::openProject() {
     auto result = ofSystemLoadDialog("Open VirtualStage Project", false, getDefaultProjectsDir());
     if (!result.bSuccess) return;
@@ -1381,6 +1389,7 @@ void ofApp::openProject() {
     if (scene.loadProject(result.filePath, &camJson)) {
         currentProjectPath = result.filePath;
         currentCloudProjectName = ""; // local project
+        currentCloudProjectId = "";
         autosaveEnabled = true;
         autosaveTimer = 0;
 
@@ -1404,6 +1413,8 @@ void ofApp::openProject() {
         // Reset undo for loaded project
         undoManager.clear();
         undoManager.pushState(scene);
+        cloudConflict = false;
+        lastAutosaveKey = autosaveKey();
 
         ofLogNotice("ofApp") << "Project loaded: " << result.filePath;
     } else {
@@ -1426,7 +1437,10 @@ void ofApp::keyPressed(int key) {
 
     // Cloud load modal: ESC to close
     if (cloudLoadState != CloudLoadState::Hidden) {
-        if (key == OF_KEY_ESC) cloudLoadState = CloudLoadState::Hidden;
+        if (key == OF_KEY_ESC) {
+            cloudLoadState = CloudLoadState::Hidden;
+            cancelCloudJobs();
+        }
         return;
     }
 
@@ -1446,11 +1460,21 @@ void ofApp::keyPressed(int key) {
         return;
     }
 
+    // Escape while downloading pauses; the partial file resumes next time
+    if (showUpdateModal && updateState == UpdateState::Downloading && key == OF_KEY_ESC) {
+        updateDownloadJob.cancel();
+        showUpdateModal = false;
+        updateState = UpdateState::Idle;
+        ofLogNotice("Update") << "Download paused";
+        return;
+    }
+
     // Close update modal on Escape (except while downloading)
     if (showUpdateModal && updateState != UpdateState::Downloading) {
         if (key == OF_KEY_ESC || updateState != UpdateState::Checking) {
             showUpdateModal = false;
             updateState = UpdateState::Idle;
+            updateCheckJob.cancel(); // a check still running must not reopen it
             return;
         }
     }
@@ -1644,11 +1668,8 @@ void ofApp::keyPressed(int key) {
         case OF_KEY_DEL: case OF_KEY_BACKSPACE:
             if (scene.getSelectionCount() > 0) {
                 pushUndo();
-                // Delete all selected in reverse order to keep indices valid
-                auto indices = scene.getSelectedIndicesSorted();
-                for (int i = (int)indices.size() - 1; i >= 0; i--) {
-                    scene.removeScreen(indices[i]);
-                }
+                // Delete all selected in one pass
+                scene.removeScreens(scene.getSelectedIndicesSorted());
                 scene.clearSelection();
                 propertiesPanel.setTarget(nullptr);
             }
@@ -1959,9 +1980,8 @@ void ofApp::loadResolumeXml(bool useInputRect) {
 
     // Clear existing screens
     pushUndo();
-    while (scene.getScreenCount() > 0) {
-        scene.removeScreen(0);
-    }
+    scene.beginBatch();
+    scene.clearScreens();
     scene.clearSelection();
     propertiesPanel.setTarget(nullptr);
 
@@ -1992,7 +2012,7 @@ void ofApp::loadResolumeXml(bool useInputRect) {
         int idx = scene.addScreen(sd.name);
         auto* screen = scene.getScreen(idx);
         if (screen) {
-            screen->plane.set(w3d, h3d, 2, 2);
+            screen->setSize(w3d, h3d);
             screen->setPosition(glm::vec3(cx, cy, 0));
 
             // Crop: slice region relative to total bounding box
@@ -2009,6 +2029,8 @@ void ofApp::loadResolumeXml(bool useInputRect) {
         }
     }
 
+    scene.commit();
+
     std::string presetName = ofFilePath::getBaseName(xmlPath);
     ofLogNotice("ofApp") << "OK: " << parsed.size() << " slices from \"" << presetName
         << "\" (" << (useInputRect ? "Input" : "Output") << "Rect)";
@@ -2511,47 +2533,32 @@ void ofApp::checkForUpdates() {
     if (updateState == UpdateState::Checking || updateState == UpdateState::Downloading) return;
     updateState = UpdateState::Checking;
     updateErrorDetail = "";
+    updateDownloadFailed = false;
     showUpdateModal = true;
 
-    std::thread([this]() {
-        // Write response to temp file using system-level HTTP tools
-        // (ofURLFileLoader local instance doesn't initialize curl properly on Windows)
-        std::string tmpPath = ofFilePath::join(ofFilePath::getUserHomeDir(), ".virtualstage_update_check.json");
-        int ret = -1;
-#ifdef TARGET_OSX
-        std::string cmd = "curl -s -H \"User-Agent: VirtualStage/" APP_VERSION "\" "
-                          "-H \"Accept: application/vnd.github.v3+json\" "
-                          "\"https://api.github.com/repos/gonzaloventura/virtualstage/releases/latest\" "
-                          "-o \"" + tmpPath + "\"";
-        ret = system(cmd.c_str());
-#elif defined(TARGET_WIN32)
-        std::string cmd = "powershell -NoProfile -Command \"[Net.ServicePointManager]::SecurityProtocol = [Net.SecurityProtocolType]::Tls12; "
-                          "Invoke-RestMethod -Uri 'https://api.github.com/repos/gonzaloventura/virtualstage/releases/latest' "
-                          "-Headers @{'User-Agent'='VirtualStage/" APP_VERSION "'} "
-                          "| ConvertTo-Json -Depth 10 | Out-File -Encoding utf8 '" + tmpPath + "'\"";
-        ret = silentSystem(cmd);
-#endif
-        if (ret != 0) {
-            updateState = UpdateState::Error;
-            updateErrorDetail = "Could not reach GitHub";
-            return;
-        }
-
-        // Read the temp file
-        ofFile f(tmpPath);
-        if (!f.exists()) {
-            updateState = UpdateState::Error;
-            updateErrorDetail = "No response received";
-            return;
-        }
-        ofBuffer buf = ofBufferFromFile(tmpPath);
-        std::string body = buf.getText();
-        ofFile::removeFile(tmpPath);
-
+    updateCheckJob = executor.submit("update", [](const Executor::CancelToken&) {
+        UpdateCheckResult r;
+        HttpClient::Request req;
+        // VIRTUALSTAGE_UPDATE_URL points the check at another release JSON,
+        // e.g. a local static server when testing the updater
+        const char* releaseUrl = getenv("VIRTUALSTAGE_UPDATE_URL");
+        req.url = releaseUrl && *releaseUrl
+            ? releaseUrl : "https://api.github.com/repos/gonzaloventura/virtualstage/releases/latest";
+        req.headers = { "Accept: application/vnd.github.v3+json" };
+        req.timeoutMs = 15000;
+        HttpClient::Response res = HttpClient::get().send(req);
+        if (res.status == 0) {
+            r.error = "Could not reach GitHub";
+            return r;
+        }
+        if (!res.ok()) {
+            r.error = "GitHub returned HTTP " + ofToString(res.status);
+            return r;
+        }
+        const std::string& body = res.body;
         if (body.empty()) {
-            updateState = UpdateState::Error;
-            updateErrorDetail = "Empty response";
-            return;
+            r.error = "Empty response";
+            return r;
         }
 
         try {
@@ -2559,17 +2566,15 @@ void ofApp::checkForUpdates() {
 
             std::string tag = json.value("tag_name", "");
             if (tag.empty()) {
-                updateState = UpdateState::Error;
-                updateErrorDetail = "No release tag found";
-                return;
+                r.error = "No release tag found";
+                return r;
             }
-            latestVersion = tag;
-            if (latestVersion[0] == 'v' || latestVersion[0] == 'V') {
-                latestVersion = latestVersion.substr(1);
+            r.version = tag;
+            if (r.version[0] == 'v' || r.version[0] == 'V') {
+                r.version = r.version.substr(1);
             }
 
             // Find platform-specific asset download URL
-            latestDownloadUrl = "";
 #ifdef TARGET_OSX
             std::string assetKeyword = "macOS";
 #elif defined(TARGET_WIN32)
@@ -2578,17 +2583,37 @@ void ofApp::checkForUpdates() {
             std::string assetKeyword = "";
 #endif
             if (json.contains("assets") && json["assets"].is_array()) {
+                std::string assetName;
                 for (auto& asset : json["assets"]) {
                     std::string name = asset.value("name", "");
+                    if (ofIsStringInString(name, ".sha256")) continue; // checksum file
                     if (!assetKeyword.empty() && name.find(assetKeyword) != std::string::npos) {
-                        latestDownloadUrl = asset.value("browser_download_url", "");
+                        assetName = name;
+                        r.downloadUrl = asset.value("browser_download_url", "");
+                        if (asset.contains("size") && asset["size"].is_number()) {
+                            r.size = asset["size"].get<int64_t>();
+                        }
+                        // GitHub publishes "digest": "sha256:<hex>" per asset
+                        if (asset.contains("digest") && asset["digest"].is_string()) {
+                            std::string digest = asset["digest"].get<std::string>();
+                            if (digest.rfind("sha256:", 0) == 0) r.sha256 = digest.substr(7);
+                        }
                         break;
                     }
                 }
+                // Otherwise a "<asset>.sha256" file next to it (sha256sum output)
+                for (auto& asset : json["assets"]) {
+                    if (!r.sha256.empty() || assetName.empty()) break;
+                    if (asset.value("name", "") != assetName + ".sha256") continue;
+                    HttpClient::Request sumReq;
+                    sumReq.url = asset.value("browser_download_url", "");
+                    HttpClient::Response sum = HttpClient::get().send(sumReq);
+                    if (sum.ok() && sum.body.size() >= 64) r.sha256 = sum.body.substr(0, 64);
+                }
             }
 
             // Compare versions (strip -beta etc. for numeric comparison)
-            std::string cleanLatest = latestVersion;
+            std::string cleanLatest = r.version;
             std::string cleanCurrent = APP_VERSION;
             auto stripSuffix = [](std::string& v) {
                 auto pos = v.find('-');
@@ -2597,17 +2622,21 @@ void ofApp::checkForUpdates() {
             stripSuffix(cleanLatest);
             stripSuffix(cleanCurrent);
 
-            if (compareVersions(cleanLatest, cleanCurrent) > 0) {
-                updateState = UpdateState::Available;
-            } else {
-                updateState = UpdateState::UpToDate;
-            }
+            r.state = compareVersions(cleanLatest, cleanCurrent) > 0
+                ? UpdateState::Available : UpdateState::UpToDate;
         } catch (const std::exception& e) {
-            updateState = UpdateState::Error;
-            updateErrorDetail = "Could not parse response";
+            r.error = "Could not parse response";
             ofLogError("Update") << "JSON parse error: " << e.what();
         }
-    }).detach();
+        return r;
+    }, [this](const UpdateCheckResult& r) {
+        updateState = r.state;
+        updateErrorDetail = r.error;
+        latestVersion = r.version;
+        latestDownloadUrl = r.downloadUrl;
+        latestSha256 = r.sha256;
+        latestSize = r.size;
+    });
 }
 
 void ofApp::startDownloadAndUpdate() {
@@ -2633,19 +2662,82 @@ void ofApp::startDownloadAndUpdate() {
 #endif
 
     updateZipPath = updateDir + "/" + zipName;
+
+    // Partial download of this version; leftovers of other versions
+    // ("<zip>.<version>.part") go, anything else in the folder stays
+    std::string partPath = updateZipPath + "." + latestVersion + ".part";
+    std::string partPrefix = zipName + ".";
+    std::error_code ec;
+    for (auto& entry : std::filesystem::directory_iterator(updateDir, ec)) {
+        std::string name = ofFilePath::getFileName(entry.path().string());
+        if (entry.is_regular_file(ec) && ofFilePath::getFileExt(name) == "part" &&
+            name.rfind(partPrefix, 0) == 0 && name != ofFilePath::getFileName(partPath)) {
+            std::filesystem::remove(entry.path(), ec);
+        }
+    }
+    uintmax_t onDisk = std::filesystem::file_size(partPath, ec);
+    updateResumedFrom = ec ? 0 : (int64_t)onDisk;
+    updateProgress.received = updateResumedFrom;
+    updateProgress.total = latestSize;
+    updateProgress.verifying = false;
+    updateStartTime = ofGetElapsedTimef();
+    if (updateResumedFrom > 0) ofLogNotice("Update") << "Resuming download at byte " << updateResumedFrom;
+
     std::string url = latestDownloadUrl;
     std::string dest = updateZipPath;
-    std::thread([this, url, dest]() {
-        auto response = ofSaveURLTo(url, dest);
-        if (response.status == 200) {
+    std::string expectedSha = latestSha256;
+    int64_t expectedSize = latestSize;
+    updateDownloadJob = executor.submit("update",
+        [this, url, partPath, dest, expectedSha, expectedSize](const Executor::CancelToken& token) {
+        std::error_code ec;
+        uintmax_t have = std::filesystem::file_size(partPath, ec);
+        bool complete = !ec && expectedSize > 0 && (int64_t)have == expectedSize;
+        if (!complete) {
+            HttpClient::Request req;
+            req.url = url;
+            req.timeoutMs = 0; // large file: stalls are caught by the client instead
+            HttpClient::Response res = HttpClient::get().download(req, partPath,
+                [this, &token](int64_t received, int64_t total) {
+                    updateProgress.received = received;
+                    if (total > 0) updateProgress.total = total;
+                    return !token.isCancelled();
+                });
+            if (token.isCancelled()) return std::string("Cancelled");
+            if (res.status == 0) {
+                ofLogError("Update") << "Download interrupted: " << res.error;
+                return std::string("Connection lost - retry to resume");
+            }
+            if (!res.ok()) return "Download failed (HTTP " + ofToString(res.status) + ")";
+        }
+
+        if (!expectedSha.empty()) {
+            updateProgress.verifying = true;
+            std::string actual;
+            if (!Sha256::fileHex(partPath, actual)) return std::string("Could not read download");
+            if (ofToLower(actual) != ofToLower(expectedSha)) {
+                ofLogError("Update") << "SHA-256 mismatch: expected " << expectedSha << ", got " << actual;
+                std::filesystem::remove(partPath, ec); // start over next time
+                return std::string("Download corrupted (checksum mismatch)");
+            }
+        } else {
+            ofLogWarning("Update") << "No SHA-256 published for this release, not verified";
+        }
+
+        std::filesystem::remove(dest, ec);
+        std::filesystem::rename(partPath, dest, ec);
+        if (ec) return "Could not move download: " + ec.message();
+        return std::string();
+    }, [this, dest](const std::string& error) {
+        if (error.empty()) {
             ofLogNotice("Update") << "Download complete: " << dest;
-            launchUpdaterAndExit();
+            launchUpdaterAndExit(); // quits from the main thread, not a worker
         } else {
             updateState = UpdateState::Error;
-            updateErrorDetail = "Download failed (HTTP " + ofToString(response.status) + ")";
-            ofLogError("Update") << "Download failed: HTTP " << response.status;
+            updateDownloadFailed = true;
+            updateErrorDetail = error;
+            ofLogError("Update") << error;
         }
-    }).detach();
+    });
 }
 
 void ofApp::launchUpdaterAndExit() {
@@ -2764,19 +2856,48 @@ void ofApp::drawUpdateModal() {
         ofDrawBitmapString("Click to download  |  Esc to close", px + panelW / 2 - 140, py + panelH - 15);
 
     } else if (updateState == UpdateState::Downloading) {
+        bool verifying = updateProgress.verifying;
+        int64_t received = updateProgress.received;
+        int64_t total = updateProgress.total;
+
         ofSetColor(255, 200, 0);
-        ofDrawBitmapString("Downloading update...", px + panelW / 2 - 84, cy);
+        std::string title = verifying ? "Verifying download..." : "Downloading update...";
+        ofDrawBitmapString(title, px + panelW / 2 - (title.length() * 8) / 2, cy);
 
-        int dots = ((int)(ofGetElapsedTimef() * 3)) % 4;
-        std::string dotsStr(dots, '.');
-        ofDrawBitmapString(dotsStr, px + panelW / 2 + 84, cy);
+        // Progress bar
+        float barX = px + 30;
+        float barW = panelW - 60;
+        float barY = cy + 18;
+        ofSetColor(70);
+        ofDrawRectangle(barX, barY, barW, 10);
+        if (total > 0) {
+            ofSetColor(255, 200, 0);
+            ofDrawRectangle(barX, barY, barW * ofClamp((float)received / total, 0.0f, 1.0f), 10);
+        }
+
+        // "12.3 / 45.6 MB  1.2 MB/s  ETA 0:35" — rate from this session's bytes only
+        const double MB = 1024.0 * 1024.0;
+        float elapsed = ofGetElapsedTimef() - updateStartTime;
+        double rate = elapsed > 1.0f ? (received - updateResumedFrom) / elapsed : 0.0;
+        std::string info = ofToString(received / MB, 1);
+        if (total > 0) info += " / " + ofToString(total / MB, 1);
+        info += " MB";
+        if (rate > 0 && !verifying) {
+            info += "  " + ofToString(rate / MB, 1) + " MB/s";
+            if (total > received) {
+                int eta = (int)((total - received) / rate);
+                info += "  ETA " + ofToString(eta / 60) + ":" + ofToString(eta % 60, 2, '0');
+            }
+        }
+        ofSetColor(180);
+        ofDrawBitmapString(info, px + panelW / 2 - (info.length() * 8) / 2, cy + 50);
 
-        ofSetColor(120);
-        ofDrawBitmapString("Please wait, do not close the app", px + panelW / 2 - 132, cy + 30);
+        ofSetColor(100);
+        ofDrawBitmapString("Esc to pause (resumes next time)", px + panelW / 2 - 128, py + panelH - 15);
 
     } else if (updateState == UpdateState::Error) {
         ofSetColor(255, 80, 80);
-        std::string title = "Could not check for updates";
+        std::string title = updateDownloadFailed ? "Update download failed" : "Could not check for updates";
         ofDrawBitmapString(title, px + panelW / 2 - (title.length() * 8) / 2, cy);
 
         if (!updateErrorDetail.empty()) {
@@ -2875,24 +2996,28 @@ void ofApp::handleAuthSubmit(AuthModal::Tab tab,
         return;
     }
 
-    // Run auth in background thread to avoid freezing the render loop
-    std::thread([this, tab, email, password]() {
-        std::string err;
-        bool success     = false;
-        bool needConfirm = false;
-
+    // Run auth in the background to avoid freezing the render loop
+    executor.submit("auth", [this, tab, email, password](const Executor::CancelToken&) {
+        AuthResult r;
         if (tab == AuthModal::Tab::Login) {
-            success = authManager.login(email, password, err);
+            r.success = authManager.login(email, password, r.error);
         } else {
-            success = authManager.signup(email, password, err, needConfirm);
+            r.success = authManager.signup(email, password, r.error, r.needConfirm);
+        }
+        return r;
+    }, [this](const AuthResult& r) {
+        if (!r.success) {
+            authModal.setError(r.error);
+        } else if (r.needConfirm) {
+            authModal.setLoading(false);
+            authModal.setSuccess("Account created! Please check your email to confirm, then sign in.");
+        } else {
+            authModal.hide();
+            cam.enableMouseInput(); // Re-enable camera after successful auth
+            fetchCloudPreferences(); // load cloud preferences after first login
+            prefetchCloudProjects();
         }
-
-        std::lock_guard<std::mutex> lock(authResultMutex);
-        pendingAuthResult.done        = true;
-        pendingAuthResult.success     = success;
-        pendingAuthResult.needConfirm = needConfirm;
-        pendingAuthResult.error       = err;
-    }).detach();
+    });
 }
 
 // ══════════════════════════════════════════════════════════════════════════════
@@ -2911,49 +3036,33 @@ void ofApp::saveToCloud() {
         name = currentCloudProjectName; // already a cloud project
     } else if (!currentProjectPath.empty()) {
         name = ofFilePath::getBaseName(currentProjectPath);
+        currentCloudProjectId = "";
     } else {
         std::string result = ofSystemTextBoxDialog("Cloud project name:", "Untitled");
         if (result.empty()) return;
         name = result;
+        currentCloudProjectId = "";
     }
 
     // Serialize current project to JSON
-    ofJson camJson;
-    auto camPos = cam.getPosition();
-    auto camTgt = cam.getTarget().getPosition();
-    camJson["position"] = {camPos.x, camPos.y, camPos.z};
-    camJson["target"]   = {camTgt.x, camTgt.y, camTgt.z};
-    camJson["distance"] = cam.getDistance();
-
-    // Write to a temp file, then read back (reuse existing serializer)
-    std::string tmpPath = ofFilePath::getUserHomeDir() + "/.virtualstage/cloud_save_tmp.json";
-    if (!scene.saveProject(tmpPath, camJson)) {
-        ofSystemAlertDialog("Failed to serialize project.");
-        return;
-    }
-    ofBuffer buf = ofBufferFromFile(tmpPath);
-    ofFile::removeFile(tmpPath);
-    if (buf.size() == 0) {
-        ofSystemAlertDialog("Failed to read project for upload.");
-        return;
-    }
-    ofJson projectData;
-    try {
-        projectData = ofJson::parse(buf.getText());
-    } catch (...) {
-        ofSystemAlertDialog("Failed to parse project JSON.");
-        return;
-    }
+    ofJson projectData = scene.toJson(getCameraJson());
 
     currentCloudProjectName = name;
+    cloudConflict = false; // an explicit save overwrites the newer server copy
+    uploadToCloud(projectData, name, autosaveKey());
+}
 
-    // Upload in a background thread
-    std::thread([this, projectData, name]() {
+void ofApp::uploadToCloud(const ofJson& data, const std::string& name, const std::string& key) {
+    executor.submit("cloud-save", [this, data, name](const Executor::CancelToken&) {
         std::string err;
-        if (!cloudStorage.saveProject(authManager.getSession(), projectData, name, err)) {
+        if (!cloudStorage.saveProject(authManager.getSession(), data, name, err)) {
             ofLogError("CloudStorage") << "Save failed: " << err;
+            return false;
         }
-    }).detach();
+        return true;
+    }, [this, key](const bool& ok) {
+        onAutosaveDone(key, ok);
+    });
 }
 
 void ofApp::loadFromCloud() {
@@ -2966,20 +3075,84 @@ void ofApp::loadFromCloud() {
     cloudProjects.clear();
     cloudLoadError.clear();
 
-    std::thread([this]() {
-        std::string err;
-        std::vector<CloudStorage::CloudProject> projects;
-        if (cloudStorage.listProjects(authManager.getSession(), projects, err)) {
-            // Store in member on main thread via flag
-            // Direct assignment is safe here since cloudLoadState == Loading
-            // and the main thread only reads these when state == Loaded/Error
-            cloudProjects  = projects;
+    // Show the last fetched list right away; the fresh one replaces it
+    if (cloudStorage.listCachedProjects(authManager.getSession(), cloudProjects)) {
+        cloudLoadState = CloudLoadState::Loaded;
+    }
+
+    cloudListJob = executor.submit("cloud-list", [this](const Executor::CancelToken&) {
+        CloudListResult r;
+        r.success = cloudStorage.listProjects(authManager.getSession(), r.projects, r.error);
+        return r;
+    }, [this](const CloudListResult& r) {
+        if (r.success) {
+            cloudProjects  = r.projects;
             cloudLoadState = CloudLoadState::Loaded;
+        } else if (cloudLoadState == CloudLoadState::Loaded) {
+            ofLogWarning("CloudStorage") << "Showing cached project list: " << r.error;
         } else {
-            cloudLoadError = err;
+            cloudLoadError = r.error;
             cloudLoadState = CloudLoadState::Error;
         }
-    }).detach();
+    });
+}
+
+// Opens from the local cache at once when there is a copy, then checks the
+// server; a newer version replaces it only if nothing was edited meanwhile
+void ofApp::openCloudProject(const std::string& projectId, const std::string& name) {
+    cloudStorage.markOpened(authManager.getSession(), projectId);
+
+    CloudProjectResult cached;
+    cached.id = projectId;
+    cached.name = name;
+    cloudOpenedVersion.clear();
+    cloudRevalidating = false;
+    if (cloudStorage.loadCachedProject(authManager.getSession(), projectId, cached.data, cached.version)) {
+        cached.success = true;
+        applyCloudProject(cached);
+        cloudOpenedVersion  = cached.version;
+        cloudOpenedSequence = scene.getJournal().getContentSequence();
+        cloudRevalidating   = true;
+    } else {
+        cloudLoadState = CloudLoadState::Loading;
+    }
+
+    cloudProjectJob = executor.submit("cloud-load", [this, projectId, name](const Executor::CancelToken&) {
+        CloudProjectResult r;
+        r.id = projectId;
+        r.name = name;
+        r.success = cloudStorage.loadProject(authManager.getSession(), projectId, r.data, r.error, &r.version);
+        return r;
+    }, [this](const CloudProjectResult& r) {
+        if (cloudOpenedVersion.empty()) {
+            applyCloudProject(r);
+            return;
+        }
+        // Opened from cache: only a newer server copy matters
+        cloudRevalidating = false;
+        if (!r.success || r.version == cloudOpenedVersion || currentCloudProjectId != r.id) return;
+        if (scene.getJournal().getContentSequence() != cloudOpenedSequence) {
+            ofLogWarning("CloudStorage") << "Newer version of " << r.name
+                                         << " on the server; kept local edits, autosave paused";
+            cloudConflict = true;
+            return;
+        }
+        ofLogNotice("CloudStorage") << "Updated " << r.name << " to the server version";
+        applyCloudProject(r);
+    });
+}
+
+void ofApp::prefetchCloudProjects() {
+    executor.submit("cloud-prefetch", [this](const Executor::CancelToken&) {
+        return cloudStorage.prefetchRecent(authManager.getSession(), 3);
+    });
+}
+
+// Closing the modal drops results still on their way
+void ofApp::cancelCloudJobs() {
+    cloudListJob.cancel();
+    // A check of the project already open is not the modal's to drop
+    if (!cloudRevalidating) cloudProjectJob.cancel();
 }
 
 void ofApp::drawCloudLoadModal() {
@@ -3085,6 +3258,7 @@ bool ofApp::handleCloudLoadModalClick(int x, int y) {
     // Click outside panel = close
     if (x < px || x > px + panelW || y < py || y > py + panelH) {
         cloudLoadState = CloudLoadState::Hidden;
+        cancelCloudJobs();
         return true;
     }
 
@@ -3098,20 +3272,9 @@ bool ofApp::handleCloudLoadModalClick(int x, int y) {
         if (x >= px + 8 && x <= px + panelW - 8 &&
             y >= iy && y < iy + itemH) {
             // Load this project
-            cloudLoadState = CloudLoadState::Loading;
             std::string projId   = cloudProjects[i].id;
             std::string projName = cloudProjects[i].name;
-            std::thread([this, projId, projName]() {
-                std::string err;
-                ofJson data;
-                bool ok = cloudStorage.loadProject(authManager.getSession(), projId, data, err);
-                std::lock_guard<std::mutex> lock(cloudProjectResultMutex);
-                pendingCloudProject.done    = true;
-                pendingCloudProject.success = ok;
-                pendingCloudProject.error   = err;
-                pendingCloudProject.name    = projName;
-                pendingCloudProject.data    = data;
-            }).detach();
+            openCloudProject(projId, projName);
             return true;
         }
     }
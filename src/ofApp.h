@@ -8,13 +8,14 @@
 #include "Gizmo.h"
 #include "PropertiesPanel.h"
 #include "UndoManager.h"
+#include "AutosaveWriter.h"
 #include "AppVersion.h"
 #include "AuthManager.h"
 #include "AuthModal.h"
 #include "CloudStorage.h"
 #include "Preferences.h"
 #include "SettingsModal.h"
-#include <mutex>
+#include "Executor.h"
 #include <atomic>
 
 enum class AppMode { Designer, View };
@@ -117,6 +118,7 @@ private:
     // Properties panel undo support
     bool propsDirty = false;
     float propsDirtyTimer = 0;
+    bool screensChanged = false; // set from Scene's journal
 
     // Helper: update properties panel based on current selection
     void updatePropertiesForSelection();
@@ -124,15 +126,22 @@ private:
     // Project save/load
     std::string currentProjectPath;
     std::string currentCloudProjectName; // non-empty = project lives in cloud
+    std::string currentCloudProjectId;   // when opened from the cloud (empty for a first save)
     void saveProject(bool saveAs = false);
     void openProject();
     void newProject();
+    ofJson getCameraJson() const; // position/target/distance, stored with the project
 
     // Autosave
     bool autosaveEnabled = false;
     float autosaveInterval = 15.0f;
     float autosaveTimer = 0.0f;
+    AutosaveWriter autosaveWriter;       // local autosave writes off the render thread
+    std::string lastAutosaveKey;         // target + scene content sequence + camera of last saved state
+    std::string pendingAutosaveKey;      // autosave written or uploaded right now, not yet confirmed
+    std::string autosaveKey() const;     // seeded after a load, so an untouched project is not saved back
     void doAutosave();
+    void onAutosaveDone(const std::string& key, bool ok); // main thread
 
     // Resolume XML import
     enum class LinkState { None, Confirm, ChooseRect };
@@ -157,7 +166,30 @@ private:
     std::string latestDownloadUrl;
     std::string updateErrorDetail;
     bool showUpdateModal = false;
+    bool updateDownloadFailed = false; // error came from the download, not the check
     std::string updateZipPath;
+    std::string latestSha256;          // published digest; empty = not published
+    int64_t     latestSize = -1;       // asset bytes; -1 = unknown
+    struct UpdateCheckResult {
+        UpdateState state = UpdateState::Error;
+        std::string version;
+        std::string downloadUrl;
+        std::string sha256;
+        int64_t     size = -1;
+        std::string error;
+    };
+    Executor::Future<UpdateCheckResult> updateCheckJob;
+
+    // Download progress: written by the worker, drawn by drawUpdateModal
+    struct UpdateProgress {
+        std::atomic<int64_t> received{0};
+        std::atomic<int64_t> total{-1};
+        std::atomic<bool>    verifying{false};
+    };
+    UpdateProgress updateProgress;
+    int64_t updateResumedFrom = 0; // bytes already on disk, excluded from the rate
+    float   updateStartTime = 0;
+    Executor::Future<std::string> updateDownloadJob; // error message; empty = ready
     void checkForUpdates();
     void startDownloadAndUpdate();
     void launchUpdaterAndExit();
@@ -171,15 +203,12 @@ private:
     AuthManager authManager;
     AuthModal   authModal;
 
-    // Background auth result (written by worker thread, read in update())
+    // Login / signup result, handled on the main thread
     struct AuthResult {
-        bool done        = false;
         bool success     = false;
         bool needConfirm = false; // email confirmation required after signup
         std::string error;
     };
-    std::mutex    authResultMutex;
-    AuthResult    pendingAuthResult;
 
     void handleAuthSubmit(AuthModal::Tab tab,
                           const std::string& email,
@@ -195,18 +224,38 @@ private:
     std::vector<CloudStorage::CloudProject> cloudProjects;
     std::string cloudLoadError;
 
-    // Background cloud result for project load
+    // Background results for the project list and a project load
+    struct CloudListResult {
+        bool success = false;
+        std::string error;
+        std::vector<CloudStorage::CloudProject> projects;
+    };
     struct CloudProjectResult {
-        bool done    = false;
         bool success = false;
         std::string error;
+        std::string id;
         std::string name;
+        std::string version; // updated_at of the data
         ofJson data;
     };
-    std::mutex         cloudProjectResultMutex;
-    CloudProjectResult pendingCloudProject;
+    Executor::Future<CloudListResult>    cloudListJob;
+    Executor::Future<CloudProjectResult> cloudProjectJob;
+    void applyCloudProject(const CloudProjectResult& result);
+    void openCloudProject(const std::string& projectId, const std::string& name);
+    void prefetchCloudProjects();
+    void cancelCloudJobs();
+
+    // Project opened from the local cache, while the server copy is checked.
+    // Cloud autosave waits for the check; if the server moved on under local
+    // edits it stays paused (cloudConflict) until the user saves explicitly.
+    std::string cloudOpenedVersion;
+    uint64_t    cloudOpenedSequence = 0; // scene content when it was opened
+    bool        cloudRevalidating = false;
+    bool        cloudConflict = false;
 
     void saveToCloud();
+    // key = autosaveKey() of the uploaded state, recorded once it is on the server
+    void uploadToCloud(const ofJson& data, const std::string& name, const std::string& key);
     void loadFromCloud();
     void drawCloudLoadModal();
     bool handleCloudLoadModalClick(int x, int y);
@@ -214,5 +263,10 @@ private:
     // ── Preferences & Settings ──────────────────────────────────────────────
     Preferences preferences;
     SettingsModal settingsModal;
-    std::atomic<bool> prefsNeedRefresh{false};
+    void fetchCloudPreferences();
+
+    // ── Background jobs ─────────────────────────────────────────────────────
+    // Network calls run here; completions are drained in update(). Declared
+    // last so it is destroyed (workers joined) before anything jobs use.
+    Executor executor;
 };